@@ -96,7 +96,8 @@ extern int main(int argc, char *argv[])
 	}
 	#endif*/
 
-	log_profile_init("profile_data.txt");
+	//2024: See --profile (LOG_PROFILE is always compiled in.)
+	//log_profile_init("profile_data.txt");
 
 	//UNDOCUMENTED
 	signal(SIGSEGV,segfault_handler); //???
@@ -996,10 +996,10 @@ void AnimCleanupWin::ok::interpolate(int key, int val)
 			auto *pp = &vl.data()[v]->m_frames.data()[f0];
 			for(auto f=fc;f-->0;)		
 			{
-				auto*c = pp[f]->m_coord;
-				auto e = pp[f]->m_interp2020;
+				auto e = pp[f].m_interp2020;
 				if(e>=Model::InterpolateStep) if(e==key||!key)	
-				{					
+				{
+					double c[3]; pp[f].getCoord(c);
 					m->setFrameAnimVertexCoords(anim,f,v,c,(Model::Interpolate2020E)val);
 				}
 			}
@@ -1175,7 +1175,7 @@ void AnimCleanupWin::ok::remove_keys(double pt, double rt, double st)
 		auto *keys = &vp->m_frames.data()[f0];
 		for(auto i=0;i<n;i++)
 		{
-			auto *kp = keys[i];
+			auto *kp = &keys[i];
 
 			if(!kp->m_interp2020) continue;
 
@@ -1190,8 +1190,8 @@ void AnimCleanupWin::ok::remove_keys(double pt, double rt, double st)
 
 			bool identical = true;
 			{
-				auto &a = *keys[pp];
-				auto &b = *keys[p];
+				auto &a = keys[pp];
+				auto &b = keys[p];
 				auto &c = *kp;
 			
 				//WARNING: I'm winging it with Step/Copy here :(
@@ -1219,7 +1219,7 @@ void AnimCleanupWin::ok::remove_keys(double pt, double rt, double st)
 
 					a.lerp(a.m_coord,c.m_coord,t,cmp);
 
-					double *cmp2 = b.m_coord;
+					const float *cmp2 = b.m_coord;
 
 					for(int k=3;k-->0;)
 					if(fabs(cmp[k]-cmp2[k])>pt) //eps
@@ -1262,7 +1262,7 @@ void AnimCleanupWin::ok::remove_frames()
 		auto *pp = &vp->m_frames.data()[f0];
 		for(auto f=fc;f-->0;)
 		{
-			if(pp[f]->m_interp2020) lp[f] = true;
+			if(pp[f].m_interp2020) lp[f] = true;
 		}
 	}
 
@@ -199,15 +199,9 @@ void GroupWin::submit(int id)
 			
 			if(g==-1) //2022
 			{				
-				//EXTREMELY INEFFECIENT
 				int_list l;
 				model->getSelectedTriangles(l);
-				for(int i:l)
-				{
-					int gg = model->getTriangleGroup(i);
-					if(gg>=0)
-					model->removeTriangleFromGroup(gg,i);
-				}
+				model->setTrianglesGroup(l,-1); //2024
 			}
 			else model->addSelectedToGroup(g); break;
 
@@ -34,6 +34,8 @@ struct ObjPrompt : Win
 	Win("OBJ Filter Options"),
 	model(model),obj(obj),
 	normals(main,"&Save Normals"),
+	share(main,"Share &Identical UVs/Normals"),
+	quantize(main,"&Compare at Decimal Places"),
 	decimal_places(main),f1_ok_cancel(main)
 	{
 		normals.set();
@@ -70,7 +72,7 @@ struct ObjPrompt : Win
 		value vertex,texture,normal;
 	};
 
-	boolean normals;
+	boolean normals,share,quantize;
 	decimal_group decimal_places;
 	f1_ok_cancel_panel f1_ok_cancel;
 };
@@ -81,6 +83,8 @@ void ObjPrompt::submit(int id)
 	case id_init:
 
 		normals.set(obj->m_saveNormals);
+		share.set(obj->m_shareCoords);
+		quantize.set(obj->m_quantize);
 		decimal_places.vertex.set_int_val(obj->m_places);
 		decimal_places.texture.set_int_val(obj->m_texPlaces);
 		decimal_places.normal.set_int_val(obj->m_normalPlaces);
@@ -89,6 +93,8 @@ void ObjPrompt::submit(int id)
 	case id_ok:
 
 		obj->m_saveNormals = normals;
+		obj->m_shareCoords = share;
+		obj->m_quantize = quantize;
 		obj->m_places = decimal_places.vertex;
 		obj->m_texPlaces = decimal_places.texture;
 		obj->m_normalPlaces = decimal_places.normal;
@@ -923,15 +923,9 @@ void SideBar::PropPanel::group_props::submit(int id)
 		int iN = model->getGroupCount();
 		if(g==-1)
 		{
-			//EXTREMELY INEFFECIENT
 			material.nav.disable();
 			material.menu.select_id(-1); //2022: Still showing old name/text?
-			for(int i:model.fselection)
-			{
-				g = model->getTriangleGroup(i);
-				if(g>=0)
-				model->removeTriangleFromGroup(g,i);
-			}
+			model->setTrianglesGroup(model.fselection,-1); //2024
 			model->operationComplete(::tr("Unset Group","operation complete"));
 		}
 		else if(g<iN) new_group:
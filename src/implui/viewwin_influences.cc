@@ -110,8 +110,7 @@ static void viewwin_influences_jointAutoAssignSelected(MainWin &model)
 
 		//log_debug("auto-assigning %p vertices and points to joints\n",model.selection.size());
 
-		for(auto&i:model.selection)
-		model->autoSetPositionInfluences(i,sensitivity,1&selected);
+		model->autoSetPositionInfluences(model.selection,sensitivity,1&selected);
 
 		model->operationComplete(::tr("Auto-Assign Selected to Bone Joints"));
 	}
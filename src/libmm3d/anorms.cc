@@ -0,0 +1,385 @@
+/*  MM3D Misfit/Maverick Model 3D
+ *
+ * Copyright (c)2004-2007 Kevin Worcester
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place-Suite 330, Boston, MA 02111-1307,
+ * USA.
+ *
+ * See the COPYING file for full license text.
+ */
+
+
+#include "mm3dtypes.h" //PCH
+
+#include "anorms.h"
+
+const float anorms_quake_table[ANORMS_QUAKE_COUNT][3] = 
+{{-0.525731f,0.000000f,0.850651f},
+{-0.442863f,0.238856f,0.864188f},
+{-0.295242f,0.000000f,0.955423f},
+{-0.309017f,0.500000f,0.809017f},
+{-0.162460f,0.262866f,0.951056f},
+{0.000000f,0.000000f,1.000000f},
+{0.000000f,0.850651f,0.525731f},
+{-0.147621f,0.716567f,0.681718f},
+{0.147621f,0.716567f,0.681718f},
+{0.000000f,0.525731f,0.850651f},
+{0.309017f,0.500000f,0.809017f},
+{0.525731f,0.000000f,0.850651f},
+{0.295242f,0.000000f,0.955423f},
+{0.442863f,0.238856f,0.864188f},
+{0.162460f,0.262866f,0.951056f},
+{-0.681718f,0.147621f,0.716567f},
+{-0.809017f,0.309017f,0.500000f},
+{-0.587785f,0.425325f,0.688191f},
+{-0.850651f,0.525731f,0.000000f},
+{-0.864188f,0.442863f,0.238856f},
+{-0.716567f,0.681718f,0.147621f},
+{-0.688191f,0.587785f,0.425325f},
+{-0.500000f,0.809017f,0.309017f},
+{-0.238856f,0.864188f,0.442863f},
+{-0.425325f,0.688191f,0.587785f},
+{-0.716567f,0.681718f,-0.147621f},
+{-0.500000f,0.809017f,-0.309017f},
+{-0.525731f,0.850651f,0.000000f},
+{0.000000f,0.850651f,-0.525731f},
+{-0.238856f,0.864188f,-0.442863f},
+{0.000000f,0.955423f,-0.295242f},
+{-0.262866f,0.951056f,-0.162460f},
+{0.000000f,1.000000f,0.000000f},
+{0.000000f,0.955423f,0.295242f},
+{-0.262866f,0.951056f,0.162460f},
+{0.238856f,0.864188f,0.442863f},
+{0.262866f,0.951056f,0.162460f},
+{0.500000f,0.809017f,0.309017f},
+{0.238856f,0.864188f,-0.442863f},
+{0.262866f,0.951056f,-0.162460f},
+{0.500000f,0.809017f,-0.309017f},
+{0.850651f,0.525731f,0.000000f},
+{0.716567f,0.681718f,0.147621f},
+{0.716567f,0.681718f,-0.147621f},
+{0.525731f,0.850651f,0.000000f},
+{0.425325f,0.688191f,0.587785f},
+{0.864188f,0.442863f,0.238856f},
+{0.688191f,0.587785f,0.425325f},
+{0.809017f,0.309017f,0.500000f},
+{0.681718f,0.147621f,0.716567f},
+{0.587785f,0.425325f,0.688191f},
+{0.955423f,0.295242f,0.000000f},
+{1.000000f,0.000000f,0.000000f},
+{0.951056f,0.162460f,0.262866f},
+{0.850651f,-0.525731f,0.000000f},
+{0.955423f,-0.295242f,0.000000f},
+{0.864188f,-0.442863f,0.238856f},
+{0.951056f,-0.162460f,0.262866f},
+{0.809017f,-0.309017f,0.500000f},
+{0.681718f,-0.147621f,0.716567f},
+{0.850651f,0.000000f,0.525731f},
+{0.864188f,0.442863f,-0.238856f},
+{0.809017f,0.309017f,-0.500000f},
+{0.951056f,0.162460f,-0.262866f},
+{0.525731f,0.000000f,-0.850651f},
+{0.681718f,0.147621f,-0.716567f},
+{0.681718f,-0.147621f,-0.716567f},
+{0.850651f,0.000000f,-0.525731f},
+{0.809017f,-0.309017f,-0.500000f},
+{0.864188f,-0.442863f,-0.238856f},
+{0.951056f,-0.162460f,-0.262866f},
+{0.147621f,0.716567f,-0.681718f},
+{0.309017f,0.500000f,-0.809017f},
+{0.425325f,0.688191f,-0.587785f},
+{0.442863f,0.238856f,-0.864188f},
+{0.587785f,0.425325f,-0.688191f},
+{0.688191f,0.587785f,-0.425325f},
+{-0.147621f,0.716567f,-0.681718f},
+{-0.309017f,0.500000f,-0.809017f},
+{0.000000f,0.525731f,-0.850651f},
+{-0.525731f,0.000000f,-0.850651f},
+{-0.442863f,0.238856f,-0.864188f},
+{-0.295242f,0.000000f,-0.955423f},
+{-0.162460f,0.262866f,-0.951056f},
+{0.000000f,0.000000f,-1.000000f},
+{0.295242f,0.000000f,-0.955423f},
+{0.162460f,0.262866f,-0.951056f},
+{-0.442863f,-0.238856f,-0.864188f},
+{-0.309017f,-0.500000f,-0.809017f},
+{-0.162460f,-0.262866f,-0.951056f},
+{0.000000f,-0.850651f,-0.525731f},
+{-0.147621f,-0.716567f,-0.681718f},
+{0.147621f,-0.716567f,-0.681718f},
+{0.000000f,-0.525731f,-0.850651f},
+{0.309017f,-0.500000f,-0.809017f},
+{0.442863f,-0.238856f,-0.864188f},
+{0.162460f,-0.262866f,-0.951056f},
+{0.238856f,-0.864188f,-0.442863f},
+{0.500000f,-0.809017f,-0.309017f},
+{0.425325f,-0.688191f,-0.587785f},
+{0.716567f,-0.681718f,-0.147621f},
+{0.688191f,-0.587785f,-0.425325f},
+{0.587785f,-0.425325f,-0.688191f},
+{0.000000f,-0.955423f,-0.295242f},
+{0.000000f,-1.000000f,0.000000f},
+{0.262866f,-0.951056f,-0.162460f},
+{0.000000f,-0.850651f,0.525731f},
+{0.000000f,-0.955423f,0.295242f},
+{0.238856f,-0.864188f,0.442863f},
+{0.262866f,-0.951056f,0.162460f},
+{0.500000f,-0.809017f,0.309017f},
+{0.716567f,-0.681718f,0.147621f},
+{0.525731f,-0.850651f,0.000000f},
+{-0.238856f,-0.864188f,-0.442863f},
+{-0.500000f,-0.809017f,-0.309017f},
+{-0.262866f,-0.951056f,-0.162460f},
+{-0.850651f,-0.525731f,0.000000f},
+{-0.716567f,-0.681718f,-0.147621f},
+{-0.716567f,-0.681718f,0.147621f},
+{-0.525731f,-0.850651f,0.000000f},
+{-0.500000f,-0.809017f,0.309017f},
+{-0.238856f,-0.864188f,0.442863f},
+{-0.262866f,-0.951056f,0.162460f},
+{-0.864188f,-0.442863f,0.238856f},
+{-0.809017f,-0.309017f,0.500000f},
+{-0.688191f,-0.587785f,0.425325f},
+{-0.681718f,-0.147621f,0.716567f},
+{-0.442863f,-0.238856f,0.864188f},
+{-0.587785f,-0.425325f,0.688191f},
+{-0.309017f,-0.500000f,0.809017f},
+{-0.147621f,-0.716567f,0.681718f},
+{-0.425325f,-0.688191f,0.587785f},
+{-0.162460f,-0.262866f,0.951056f},
+{0.442863f,-0.238856f,0.864188f},
+{0.162460f,-0.262866f,0.951056f},
+{0.309017f,-0.500000f,0.809017f},
+{0.147621f,-0.716567f,0.681718f},
+{0.000000f,-0.525731f,0.850651f},
+{0.425325f,-0.688191f,0.587785f},
+{0.587785f,-0.425325f,0.688191f},
+{0.688191f,-0.587785f,0.425325f},
+{-0.955423f,0.295242f,0.000000f},
+{-0.951056f,0.162460f,0.262866f},
+{-1.000000f,0.000000f,0.000000f},
+{-0.850651f,0.000000f,0.525731f},
+{-0.955423f,-0.295242f,0.000000f},
+{-0.951056f,-0.162460f,0.262866f},
+{-0.864188f,0.442863f,-0.238856f},
+{-0.951056f,0.162460f,-0.262866f},
+{-0.809017f,0.309017f,-0.500000f},
+{-0.864188f,-0.442863f,-0.238856f},
+{-0.951056f,-0.162460f,-0.262866f},
+{-0.809017f,-0.309017f,-0.500000f},
+{-0.681718f,0.147621f,-0.716567f},
+{-0.681718f,-0.147621f,-0.716567f},
+{-0.850651f,0.000000f,-0.525731f},
+{-0.688191f,0.587785f,-0.425325f},
+{-0.587785f,0.425325f,-0.688191f},
+{-0.425325f,0.688191f,-0.587785f},
+{-0.425325f,-0.688191f,-0.587785f},
+{-0.587785f,-0.425325f,-0.688191f},
+{-0.688191f,-0.587785f,-0.425325f}};
+
+unsigned anorms_quake_search(const float n[3])
+{
+	float bestDistance = 10000; //3 should do it?
+	unsigned bestIndex = 0;
+
+	for(unsigned t=0;t<ANORMS_QUAKE_COUNT;t++)
+	{
+		float x = n[0]-anorms_quake_table[t][0];
+		float y = n[1]-anorms_quake_table[t][1];
+		float z = n[2]-anorms_quake_table[t][2];
+
+		float distance = x*x+y*y+z*z;
+
+		if(distance<bestDistance)
+		{
+			bestIndex = t;
+			bestDistance = distance;
+		}
+	}
+	return bestIndex;
+}
+
+//The table divides each cube face into CELLS*CELLS cells. Each cell
+//lists the normals that can be nearest for some direction inside it
+//in ascending order. Distances are only compared among them, in the 
+//same way anorms_quake_search does, so the result is identical.
+//
+// Normals that aren't within 0.001 of unit length use the search.
+//
+enum{ ANORMS_CELLS=64 };
+static const float anorms_min_len2 = 0.999f*0.999f;
+static const float anorms_max_len2 = 1.001f*1.001f;
+
+struct anorms_cube
+{
+	std::vector<unsigned> first; //6*CELLS*CELLS+1
+	std::vector<uint8_t> list;
+
+	anorms_cube();
+
+	static unsigned cell(const float n[3]);
+};
+unsigned anorms_cube::cell(const float n[3])
+{
+	float ax = fabsf(n[0]), ay = fabsf(n[1]), az = fabsf(n[2]);
+
+	int f; float m,u,v;
+	if(ax>=ay&&ax>=az){ f = 0; m = n[0]; u = n[1]; v = n[2]; }
+	else if(ay>=az){ f = 1; m = n[1]; u = n[0]; v = n[2]; }
+	else{ f = 2; m = n[2]; u = n[0]; v = n[1]; }
+	if(m<0){ f+=3; m = -m; }
+
+	int i = (int)((u/m+1)*(ANORMS_CELLS*0.5f));
+	int j = (int)((v/m+1)*(ANORMS_CELLS*0.5f));
+	i = std::max(0,std::min(ANORMS_CELLS-1,i));
+	j = std::max(0,std::min(ANORMS_CELLS-1,j));
+
+	return (f*ANORMS_CELLS+j)*ANORMS_CELLS+i;
+}
+anorms_cube::anorms_cube()
+{
+	//Each cell is bounded by a cone around its middle (the corners
+	//are the farthest points.) For each normal the distance is then
+	//bounded below and above over the cone and over the lengths the
+	//table accepts. Any normal whose lower bound isn't greater than
+	//the least upper bound can be nearest.
+	const double r0 = sqrt(anorms_min_len2), r1 = sqrt(anorms_max_len2);
+	const double step = 2.0/ANORMS_CELLS;
+	const double margin = 1e-3; //Radians. For float rounding.
+
+	double len[ANORMS_QUAKE_COUNT],dir[ANORMS_QUAKE_COUNT][3];
+	for(int k=0;k<ANORMS_QUAKE_COUNT;k++)
+	{
+		auto *q = anorms_quake_table[k];
+		len[k] = sqrt((double)q[0]*q[0]+(double)q[1]*q[1]+(double)q[2]*q[2]);
+		for(int c=3;c-->0;) dir[k][c] = q[c]/len[k];
+	}
+
+	first.reserve(6*ANORMS_CELLS*ANORMS_CELLS+1);
+	for(int f=0;f<6;f++)
+	for(int j=0;j<ANORMS_CELLS;j++)
+	for(int i=0;i<ANORMS_CELLS;i++)
+	{
+		int a = f%3, b = a?0:1, c = a==2?1:2; //See cell.
+		double m = f<3?1:-1;
+		auto point = [&](double u, double v, double *p)
+		{
+			p[a] = m; p[b] = u; p[c] = v;
+			double l = sqrt(p[0]*p[0]+p[1]*p[1]+p[2]*p[2]);
+			for(int k=3;k-->0;) p[k]/=l;
+		};
+		double u0 = -1+i*step, v0 = -1+j*step;
+		double axis[3]; point(u0+step/2,v0+step/2,axis);
+		double cone = 0;
+		for(int k=0;k<4;k++)
+		{
+			double p[3]; point(u0+(k&1)*step,v0+(k>>1)*step,p);
+			double d = axis[0]*p[0]+axis[1]*p[1]+axis[2]*p[2];
+			cone = std::max(cone,acos(std::min(1.0,d)));
+		}
+		cone+=margin;
+
+		double lo[ANORMS_QUAKE_COUNT], least = DBL_MAX;
+		for(int k=0;k<ANORMS_QUAKE_COUNT;k++)
+		{
+			double d = axis[0]*dir[k][0]+axis[1]*dir[k][1]+axis[2]*dir[k][2];
+			double angle = acos(std::max(-1.0,std::min(1.0,d)));
+			double c0 = cos(std::min(PI,angle+cone));
+			double c1 = cos(std::max(0.0,angle-cone));
+
+			//distance = |p|^2+|q|^2-2|p||q|cos. |p|^2 is the same for
+			//every normal so it's left out.
+			double l2 = len[k]*len[k];
+			lo[k] = l2-2*len[k]*std::max(r0*c1,r1*c1);
+			double hi = l2-2*len[k]*std::min(r0*c0,r1*c0);
+			least = std::min(least,hi);
+		}
+		first.push_back((unsigned)list.size());
+		for(int k=0;k<ANORMS_QUAKE_COUNT;k++)
+		{
+			if(lo[k]<=least+1e-4) list.push_back((uint8_t)k);
+		}
+	}
+	first.push_back((unsigned)list.size());
+}
+
+static const anorms_cube &anorms_get_cube()
+{
+	static const anorms_cube cube; return cube; //Thread safe.
+}
+
+unsigned anorms_quake(const float n[3])
+{
+	float l2 = n[0]*n[0]+n[1]*n[1]+n[2]*n[2];
+	if(!(l2>=anorms_min_len2&&l2<=anorms_max_len2))
+	{
+		return anorms_quake_search(n); //Also NaN.
+	}
+
+	auto &cube = anorms_get_cube();
+	unsigned c = cube.cell(n);
+	auto *it = cube.list.data()+cube.first[c];
+	auto *itt = cube.list.data()+cube.first[c+1];
+
+	float bestDistance = 10000;
+	unsigned bestIndex = 0;
+	for(;it<itt;it++)
+	{
+		auto *q = anorms_quake_table[*it];
+		float x = n[0]-q[0];
+		float y = n[1]-q[1];
+		float z = n[2]-q[2];
+
+		float distance = x*x+y*y+z*z;
+
+		if(distance<bestDistance)
+		{
+			bestIndex = *it;
+			bestDistance = distance;
+		}
+	}
+	return bestIndex;
+}
+void anorms_quake(size_t n, const float *xyz, uint8_t *out)
+{
+	anorms_get_cube();
+
+	for(size_t i=0;i<n;i++,xyz+=3) out[i] = (uint8_t)anorms_quake(xyz);
+}
+
+uint16_t anorms_md3(const double n[3])
+{
+	int16_t lng;
+	int16_t lat;
+	if(n[0]==0&&n[1]==0)
+	{
+		if(n[2]>0)
+		{
+			lng = 0;
+			lat = 0;
+		}
+		else
+		{
+			lat = 128;
+			lng = 0;
+		}
+	}
+	else
+	{
+		lng = (int16_t)(acos(n[2])*255/(2 *PI));
+		lat = (int16_t)(atan2(n[1],n[0])*255/(2 *PI));
+	}
+	return (uint16_t)(((lat &255)*256)|(lng &255));
+}
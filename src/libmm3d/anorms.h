@@ -0,0 +1,53 @@
+/*  MM3D Misfit/Maverick Model 3D
+ *
+ * Copyright (c)2004-2007 Kevin Worcester
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place-Suite 330, Boston, MA 02111-1307,
+ * USA.
+ *
+ * See the COPYING file for full license text.
+ */
+
+
+
+#ifndef __ANORMS_H
+#define __ANORMS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+//2024: Normal quantization for the Quake model formats. The MD2 one
+//picks the nearest of Quake's 162 normals. It uses a cube-map table
+//of candidates so each normal is compared to just a few of them, but
+//the result is the same as comparing it with all 162 (ties included.)
+
+enum{ ANORMS_QUAKE_COUNT=162 };
+
+extern const float anorms_quake_table[ANORMS_QUAKE_COUNT][3];
+
+//Index of the normal closest to n (squared distance) or the first of
+//equally close normals. n should be unit length but needn't be.
+extern unsigned anorms_quake(const float n[3]);
+
+//Same as anorms_quake for n normals (xyz is n*3.)
+extern void anorms_quake(size_t n, const float *xyz, uint8_t *out);
+
+//Brute force version of anorms_quake.
+extern unsigned anorms_quake_search(const float n[3]);
+
+//MD3's 16-bit latitude/longitude encoding.
+extern uint16_t anorms_md3(const double n[3]);
+
+#endif // __ANORMS_H
@@ -22,6 +22,8 @@
 
 #include "mm3dtypes.h" //PCH
 
+#include <chrono> //2024
+
 #include "glheaders.h"
 //#include "bsptree.h"
 #include "log.h"
@@ -53,6 +55,8 @@ struct Model::BspTree::Poly
 
 	void split(int i1, int i2, int i3, Poly*, float t);
 	void split2(int,int,int, Poly*,Poly*, float,float t2);
+
+	void render(Draw&); //2024
 };
 struct Model::BspTree::Node
 {
@@ -68,6 +72,7 @@ struct Model::BspTree::Node
 	}
 
 	void partition();
+	void choose(); //2024
 	
 	enum{ LEFT=-1,SAME,RIGHT,BOTH };
 
@@ -121,12 +126,93 @@ void Model::BspTree::addTriangles(Model *m, int_list &l)
 	}
 	m_root->first = p;
 }
-void Model::BspTree::partition()
+void Model::BspTree::partition(SortE sort)
+{
+	m_sort = sort;
+
+	auto t0 = std::chrono::steady_clock::now();
+
+	Stats st = {};
+	if(m_root) for(Poly*p=m_root->first;p;p=p->next)
+	{
+		st.triangles++;
+	}
+	if(m_root&&sort==SORT_BSP)
+	{
+		//2024: This was recursive. Convex shapes put everything on
+		//one side of every plane so the tree can be a long chain.
+		std::vector<std::pair<Node*,int>> stack(1,{m_root,1});
+		while(!stack.empty())
+		{
+			auto n = stack.back(); stack.pop_back();
+
+			n.first->partition();
+
+			st.nodes++; st.depth = std::max(st.depth,n.second);
+
+			for(Poly*p=n.first->first;p;p=p->next) st.polys++;
+
+			if(auto*l=n.first->left) stack.push_back({l,n.second+1});
+			if(auto*r=n.first->right) stack.push_back({r,n.second+1});
+		}
+	}
+	else if(m_root)
+	{
+		st.nodes = st.depth = 1; st.polys = st.triangles;
+	}
+
+	auto t1 = std::chrono::steady_clock::now();
+	st.ms = std::chrono::duration<double,std::milli>(t1-t0).count();
+	s_stats = st;
+}
+void Model::BspTree::Node::choose()
 {
-	if(m_root) m_root->partition();
+	//2024: This had always split on the first polygon. Instead try
+	//a few candidates spread through the list, and score them on a
+	//sample of the rest by how many polygons they cut and how many
+	//more go on one side than the other.
+	enum{ candidates=4, samples=32, split_cost=4 };
+
+	thread_local std::vector<Poly*> v; v.clear();
+
+	for(Poly*p=first;p;p=p->next) v.push_back(p);
+
+	size_t n = v.size(); if(n<3) return;
+
+	size_t cn = std::min<size_t>(candidates,n);
+	size_t step = std::max<size_t>(1,n/samples);
+
+	size_t best = 0; int best_score = INT_MAX;
+
+	for(size_t c=0;c<cn;c++)
+	{
+		size_t i = c*n/cn;
+
+		first = v[i]; d = abc_dot_product(first->v[0].coord);
+
+		int count[BOTH-LEFT+1] = {};
+		for(size_t j=0;j<n;j+=step) if(j!=i)
+		{
+			count[side(v[j]).result-LEFT]++;
+		}
+		int score = split_cost*count[BOTH-LEFT];
+		score+=abs(count[LEFT-LEFT]-count[RIGHT-LEFT]);
+
+		if(score<best_score)
+		{
+			best = i; best_score = score; if(!score) break;
+		}
+	}
+
+	first = v[best]; if(best) //Move to front.
+	{
+		v[best-1]->next = first->next; first->next = v[0];
+	}
 }
 void Model::BspTree::Node::partition()
 {
+	choose(); //2024
+
 	d = abc_dot_product(first->v[0].coord);
 
 	Poly *_l[3] = {}, **l = _l-LEFT; //YUCK!
@@ -134,6 +220,7 @@ void Model::BspTree::Node::partition()
 	//NOTE: Sometimes code will try to pick a polygon
 	//to divide the half-spaces more evenly. A random
 	//pick might help but is messier with linked list.
+	//2024: See choose.
 	for(Poly*q,*p=first->next;p;p=q)
 	{
 		q = p->next;
@@ -177,7 +264,7 @@ void Model::BspTree::Node::partition()
 
 		(i==LEFT?left:right) = np;
 
-		np->first = l[i]; np->partition();
+		np->first = l[i]; //np->partition(); //2024
 	}
 }
 
@@ -309,7 +396,30 @@ void Model::BspTree::render(double point[3], Draw &context)
 	//glEnable(GL_TEXTURE_2D); //???
 	{
 		glBegin(GL_TRIANGLES);
-		m_root->render(pointf,context); //point
+		if(m_sort==SORT_BSP)
+		{
+			m_root->render(pointf,context); //point
+		}
+		else if(m_sort==SORT_CENTERS) //2024
+		{
+			thread_local std::vector<std::pair<float,Poly*>> v; v.clear();
+
+			for(;p;p=p->next)
+			{
+				float dist = 0; for(int i=3;i-->0;)
+				{
+					float c = (p->v[0].coord[i]+p->v[1].coord[i]+p->v[2].coord[i])/3;
+					c-=pointf[i]; dist+=c*c;
+				}
+				v.push_back({dist,p});
+			}
+			std::stable_sort(v.begin(),v.end(),[](auto &a, auto &b)
+			{
+				return a.first>b.first; //Back to front.
+			});
+			for(auto&ea:v) ea.second->render(context);
+		}
+		else for(;p;p=p->next) p->render(context); //SORT_NONE
 		glEnd();
 	}
 	//glDisable(GL_TEXTURE_2D); //NEW
@@ -321,54 +431,68 @@ void Model::BspTree::render(double point[3], Draw &context)
 }
 void Model::BspTree::Node::render(float point[3], Draw &context)
 {
-	bool r = abc_dot_product(point)<d;
-
-	if(auto*n=r?right:left) n->render(point,context);
+	//2024: This was recursive (see BspTree::partition.)
+	thread_local std::vector<Node*> stack; 
+	
+	size_t base = stack.size();
 
-	for(Poly*p=first;p;p=p->next)
+	for(Node*n=this;;)
 	{
-		auto *t = p->triangle;
+		for(;n;n=n->abc_dot_product(point)<n->d?n->right:n->left)
+		{
+			stack.push_back(n);
+		}
+		if(stack.size()==base) break;
 
-		if(!t->visible(context.layers)) continue;
+		n = stack.back(); stack.pop_back();
 
-		if(context.bsp_group!=t->m_group) 
-		{
-			context.bsp_group = t->m_group; //material
+		for(Poly*p=n->first;p;p=p->next) p->render(context);
 
-			glEnd();
+		n = n->abc_dot_product(point)<n->d?n->left:n->right;
+	}
+}
+void Model::BspTree::Poly::render(Draw &context)
+{
+	auto *t = triangle;
 
-			context.bsp->_drawMaterial(context,context.bsp_group);
+	if(!t->visible(context.layers)) return;
 
-			if(context.bsp_selected!=t->m_selected)
-			goto selected;
+	if(context.bsp_group!=t->m_group) 
+	{
+		context.bsp_group = t->m_group; //material
+
+		glEnd();
+
+		context.bsp->_drawMaterial(context,context.bsp_group);
 
-			glBegin(GL_TRIANGLES);
-		}
 		if(context.bsp_selected!=t->m_selected)
-		{
-			context.bsp_selected = t->m_selected; //red light
+		goto selected;
 
-			glEnd(); selected: //OPTIMIZING?
-			glDisable(context.bsp_selected?GL_LIGHT0:GL_LIGHT1);
-			glEnable(context.bsp_selected?GL_LIGHT1:GL_LIGHT0);
-			glBegin(GL_TRIANGLES);
-		}
+		glBegin(GL_TRIANGLES);
+	}
+	if(context.bsp_selected!=t->m_selected)
+	{
+		context.bsp_selected = t->m_selected; //red light
 
-		for(auto&v:p->v)
-		{
-			glTexCoord2fv(v.st);
-			glNormal3fv(v.drawNormals);
-			glVertex3fv(v.coord);
-		}
+		glEnd(); selected: //OPTIMIZING?
+		glDisable(context.bsp_selected?GL_LIGHT0:GL_LIGHT1);
+		glEnable(context.bsp_selected?GL_LIGHT1:GL_LIGHT0);
+		glBegin(GL_TRIANGLES);
 	}
 
-	if(auto*n=r?left:right) n->render(point,context);
+	for(auto&ea:v)
+	{
+		glTexCoord2fv(ea.st);
+		glNormal3fv(ea.drawNormals);
+		glVertex3fv(ea.coord);
+	}
 }
 
-std::vector<Model::BspTree::Node*> Model::BspTree::s_recycle;
-std::vector<Model::BspTree::Poly*> Model::BspTree::s_recycle2;
-int Model::BspTree::s_allocated = 0;
-int Model::BspTree::s_allocated2 = 0;
+thread_local std::vector<Model::BspTree::Node*> Model::BspTree::s_recycle;
+thread_local std::vector<Model::BspTree::Poly*> Model::BspTree::s_recycle2;
+std::atomic<int> Model::BspTree::s_allocated(0);
+std::atomic<int> Model::BspTree::s_allocated2(0);
+thread_local Model::BspTree::Stats Model::BspTree::s_stats = {};
 Model::BspTree::Node *Model::BspTree::Node::get()
 {
 	if(!s_recycle.empty())
@@ -384,14 +508,21 @@ Model::BspTree::Node *Model::BspTree::Node::get()
 }
 void Model::BspTree::Node::release()
 {
-	if(left) left->release();	
-	if(right) right->release();
-	for(auto*p=first;p;p=p->next)
+	//2024: This was recursive (see BspTree::partition.)
+	std::vector<Node*> stack(1,this);
+	while(!stack.empty())
 	{
-		//p->release();
-		s_recycle2.push_back(p);
+		Node *n = stack.back(); stack.pop_back();
+
+		if(n->left) stack.push_back(n->left);
+		if(n->right) stack.push_back(n->right);
+		for(auto*p=n->first;p;p=p->next)
+		{
+			//p->release();
+			s_recycle2.push_back(p);
+		}
+		s_recycle.push_back(n);
 	}
-	s_recycle.push_back(this);
 }
 Model::BspTree::Poly *Model::BspTree::Poly::get()
 {
@@ -407,8 +538,11 @@ Model::BspTree::Poly *Model::BspTree::Poly::get()
 
 void Model::BspTree::stats()
 {
-	log_debug("Model::BspTree::Node: %d/%d\n",s_recycle.size(),s_allocated);
-	log_debug("Model::BspTree::Poly: %d/%d\n",s_recycle2.size(),s_allocated2);
+	log_debug("Model::BspTree::Node: %d/%d\n",s_recycle.size(),(int)s_allocated);
+	log_debug("Model::BspTree::Poly: %d/%d\n",s_recycle2.size(),(int)s_allocated2);
+	auto &st = s_stats; //2024
+	log_debug("Model::BspTree: %d triangles, %d polygons, %d nodes, %d deep, %.3f ms\n",
+	st.triangles,st.polys,st.nodes,st.depth,st.ms);
 }
 int Model::BspTree::flush()
 {
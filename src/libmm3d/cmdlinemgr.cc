@@ -119,6 +119,7 @@ bool CommandLineManager::parse(int argc, const char ** argv)
 		Option *opt = nullptr;
 		const char *arg = nullptr;
 		int nextOpt = a;
+		bool equals = strchr(str,'=')!=nullptr; //2024
 
 		// It is an option
 		if(str[1]=='-')
@@ -171,7 +172,7 @@ bool CommandLineManager::parse(int argc, const char ** argv)
 				return false;
 			}
 		}
-		else
+		else if(!equals) //2024: --profile=file
 		{
 			arg = "";
 		}
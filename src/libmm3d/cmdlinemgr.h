@@ -86,6 +86,8 @@ public:
 	ErrorE error()const { return m_error; }
 	int errorArgument()const { return m_errorArg; }
 
+	//2024: If takesArg is false an argument can still be given
+	//with = (e.g. --profile=file) but the next one isn't taken.
 	void addOption(int id,char shortOption, const char *longOption = nullptr,
 			const char *defaultValue = nullptr,bool takesArg = false);
 	void addCustomOption(int id,Option *opt);
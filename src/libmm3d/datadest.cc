@@ -26,6 +26,8 @@
 //#include "endianconfig.h"
 #include "mm3dport.h"
 
+#include <charconv> //2024
+
 DestCloser::DestCloser(DataDest *src)
 	: m_src(src)
 {
@@ -45,6 +47,7 @@ DataDest::DataDest()
 	  m_errorOccurred(false),
 	  m_atFileLimit(false),
 	  m_errno(0),
+	  m_textLen(0),
 	  //m_endfunc16(htol_u16),
 	  //m_endfunc32(htol_u32),
 	  //m_endfuncfl(htol_float)
@@ -82,6 +85,8 @@ void DataDest::setFileSizeLimit(size_t bytes)
 
 bool DataDest::seek(off_t offset)
 {
+	flushText(); //2024
+
 	if(m_hasLimit&&(size_t)offset>m_fileSizeLimit)
 	{
 		setAtFileLimit(true);
@@ -133,6 +138,8 @@ bool DataDest::canWrite(size_t bytes)
 template<class T>
 inline bool DataDest::_write(T &val)
 {
+	if(m_textLen) flushText(); //2024
+
 	if(!canWrite(sizeof(T))) return false;
 
 	if(m_swap) swapEndianness(val);
@@ -149,6 +156,8 @@ bool DataDest::write(float val){ return _write(val); }
 
 bool DataDest::writeBytes(const void *buf, size_t bufLen)
 {
+	if(m_textLen) flushText(); //2024
+
 	if(!canWrite(bufLen)) return false;
 
 	return internalWrite((uint8_t*)buf,bufLen);
@@ -206,3 +215,64 @@ bool DataDest::writeBytes(const void *buf, size_t bufLen)
 	return writeBytes(buf,len)?len:-1;
 }
 
+bool DataDest::flushText()
+{
+	if(!m_textLen) return true;
+
+	size_t len = m_textLen; m_textLen = 0;
+
+	return internalWrite((uint8_t*)m_text.data(),len);
+}
+char *DataDest::_text_room(size_t bytes)
+{
+	if(m_textLen+bytes>m_text.size())
+	{
+		flushText();
+
+		if(bytes>m_text.size())
+		m_text.resize(std::max<size_t>(bytes,TEXT_BUFFER_SIZE));
+	}
+	return m_text.data()+m_textLen;
+}
+DataDest &DataDest::_text_commit(size_t bytes)
+{
+	//Note, canWrite keeps offset/getFileSize current.
+	if(canWrite(bytes)) m_textLen+=bytes; return *this;
+}
+DataDest &DataDest::text(const char *str, size_t len)
+{
+	memcpy(_text_room(len),str,len); return _text_commit(len);
+}
+DataDest &DataDest::text(char c)
+{
+	*_text_room(1) = c; return _text_commit(1);
+}
+DataDest &DataDest::text(int i)
+{
+	char *p = _text_room(16);
+	return _text_commit(std::to_chars(p,p+16,i).ptr-p);
+}
+DataDest &DataDest::text(unsigned i)
+{
+	char *p = _text_room(16);
+	return _text_commit(std::to_chars(p,p+16,i).ptr-p);
+}
+DataDest &DataDest::text(double f, int places, bool trim)
+{
+	//%f of DBL_MAX is 309 digits.
+	size_t room = 320+std::max(places,0);
+	char *p = _text_room(room);
+
+	#if __cpp_lib_to_chars>=201611L
+	size_t len = std::to_chars(p,p+room,f,std::chars_format::fixed,places).ptr-p;
+	#else
+	size_t len = snprintf(p,room,"%.*f",places,f);
+	for(size_t i=len;i-->0;) if(p[i]==',') p[i] = '.'; //locale
+	#endif
+
+	if(trim&&places>0&&memchr(p,'.',len))
+	{
+		while(p[len-1]=='0'&&p[len-2]!='.') len--;
+	}
+	return _text_commit(len);
+}
@@ -105,7 +105,7 @@ class DataDest
 		void swapEndianness(){ m_swap = !m_swap; } //2021 (UNUSED)
 
 		// Perform any cleanup when done writing.
-		void close(){ internalClose(); }
+		void close(){ flushText(); internalClose(); }
 
 		// Returns the size of the output written so far.
 		size_t getFileSize(){ return m_fileSize; }
@@ -151,6 +151,20 @@ class DataDest
 		// Writes a null-terminated string to output (not including null)
 		/*ssize_t*/intptr_t writeString(const char *str);
 
+		//2024: Buffered text output. This is for large text files where
+		//printf is a bottleneck. The buffer is written before any other
+		//write operation (or seek/close.) Numbers come out the same as
+		//printf's %d and %.*f in the "C" locale. trim removes trailing
+		//zeroes except for one after the decimal point.
+		DataDest &text(const char *str){ return text(str,strlen(str)); }
+		DataDest &text(const char *str, size_t len);
+		DataDest &text(char c);
+		DataDest &text(int i);
+		DataDest &text(unsigned i);
+		DataDest &text(double f, int places, bool trim=false);
+		DataDest &textLine(){ return text("\r\n",2); }
+		bool flushText();
+
 		// Write an integer value of the specified size and store it in val.
 		// Returns false if a write error occurred.
 		bool write(int8_t val);
@@ -179,9 +193,14 @@ class DataDest
 	private:
 		bool canWrite(size_t bytes);
 
+		char *_text_room(size_t bytes);
+		DataDest &_text_commit(size_t bytes);
+
 		enum
 		{
-			MAX_PRINTF_SIZE = 2<<13 //16*1024 //2^14
+			MAX_PRINTF_SIZE = 2<<13, //16*1024 //2^14
+
+		TEXT_BUFFER_SIZE = 1<<16, //2024
 		};
 
 		//EndiannessE m_endian; //UNUSED
@@ -198,6 +217,8 @@ class DataDest
 		//char m_strbuf[MAX_PRINTF_SIZE];
 		std::vector<char> m_vpfbuf;
 
+		std::vector<char> m_text; size_t m_textLen; //2024
+
 		/*REMOVE ME? (USE ME?)
 		typedef uint16_t (*EndianFunction16T)(uint16_t);
 		typedef uint32_t (*EndianFunction32T)(uint32_t);
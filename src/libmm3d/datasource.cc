@@ -292,3 +292,47 @@ bool DataSource::readBytes(void *vbuf, size_t bufLen)
 	return true;
 }
 
+const uint8_t *DataSource::readDirect(size_t bufLen)
+{
+	if(bufLen>getRemaining())
+	{
+		seek(m_fileSize);
+		setUnexpectedEof(true);
+		return nullptr;
+	}
+	if(m_bufLen<bufLen)
+	{
+		if(!internalReadAt(m_bufOffset,&m_buf,&m_bufLen)||m_bufLen<bufLen)
+		{
+			return nullptr;
+		}
+	}
+	auto *ret = m_buf; advanceBytes(bufLen); return ret;
+}
+
+bool DataSource::_readArray(void *buf, size_t n, size_t size)
+{
+	if(!readBytes(buf,n*size)) return false;
+
+	if(m_swap) switch(size) //Written to be vectorized.
+	{
+	case 2:
+		for(auto*p=(uint16_t*)buf,*d=p+n;p<d;p++)
+		*p = (uint16_t)(*p<<8|*p>>8);
+		break;
+	case 4:
+		for(auto*p=(uint32_t*)buf,*d=p+n;p<d;p++)
+		*p = *p<<24|(*p<<8&0xff0000)|(*p>>8&0xff00)|*p>>24;
+		break;
+	case 8:
+		for(auto*p=(uint64_t*)buf,*d=p+n;p<d;p++)
+		{
+			uint64_t x = *p;
+			x = x<<32|x>>32;
+			x = (x&0x0000ffff0000ffffull)<<16|(x>>16&0x0000ffff0000ffffull);
+			*p = (x&0x00ff00ff00ff00ffull)<<8|(x>>8&0x00ff00ff00ff00ffull);
+		}
+		break;
+	}
+	return true;
+}
@@ -183,6 +183,20 @@ class DataSource
 		// Returns false if a read error occurred.
 		bool readLine(char *buf, size_t bufLen,bool *foundNewline = nullptr);
 
+		//2024: Returns a pointer to the next bufLen bytes and advances
+		//past them. This is nullptr if the bytes aren't in the source's
+		//buffer (nothing is read then) or if they're past the end. With
+		//MmapDataSource and MemDataSource it's never nullptr if there's
+		//enough input.
+		const uint8_t *readDirect(size_t bufLen);
+
+		//2024: Reads n values of type T into buf, converting their byte
+		//order all at once.
+		template<class T> bool readArray(T *buf, size_t n)
+		{
+			return _readArray(buf,n,sizeof(T));
+		}
+
 		// Read an integer value of the specified size and store it in val.
 		// Returns false if a read error occurred.
 		bool read(int8_t &val);
@@ -228,6 +242,7 @@ class DataSource
 
 	private:
 		bool requireBytes(size_t bytes);
+		bool _readArray(void *buf, size_t n, size_t size);
 		void advanceBytes(size_t bytes);
 		bool fillBuffer();
 
@@ -28,6 +28,7 @@
 #include "datasource.h"
 #include "filedatadest.h"
 #include "filedatasource.h"
+#include "mmapdatasource.h"
 
 FileFactory::FileFactory()
 {
@@ -85,6 +86,12 @@ DataDest *FileFactory::createDest(const char *filename)
 
 DataSource *FileFactory::createSource(const char *filename)
 {
+	//2024: Regular files are mapped into memory. FileDataSource is
+	//still used for anything else and to report errors.
+	auto *mm = new MmapDataSource(filename);
+	if(!mm->errorOccurred()) return mm;
+	delete mm;
+
 	return new FileDataSource(filename);
 }
 
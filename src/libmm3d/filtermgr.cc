@@ -95,6 +95,8 @@ const char *FilterManager::getAllWriteTypes(bool exportModel)
 
 Model::ModelErrorE FilterManager::readFile(Model *model, const char *filename)
 {
+	LOG_PROFILE(); //2024
+
 	//NEW: The individual filters are reimplementing this??
 	if(!model||!filename||!*filename) 
 	{
@@ -147,6 +149,8 @@ Model::ModelErrorE FilterManager::readFile(Model *model, const char *filename)
 
 Model::ModelErrorE FilterManager::writeFile(Model *model, const char *filename, bool exportModel, FilterManager::WriteOptionsE wo)
 {	
+	LOG_PROFILE(); //2024
+
 	//NEW: The individual filters are reimplementing this??
 	if(!model||!filename||!*filename) 
 	{
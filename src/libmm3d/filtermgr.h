@@ -62,6 +62,12 @@ public:
 	static FilterManager *getInstance();
 	static void release();
 
+	//2024: Filters keep state while reading/writing, so threads can't
+	//share them. These make/delete a separate manager for a worker to
+	//register its own filters with. (See init_std_filters.)
+	static FilterManager *create(){ return new FilterManager; }
+	void destroy(){ delete this; }
+
 	void registerFilter(ModelFilter *filter);
 
 	Model::ModelErrorE readFile(Model *model, const char *filename);
@@ -61,6 +61,13 @@ Model::ModelErrorE IqeFilter::readFile(Model *model, const char *const filename)
 	return Model::ERROR_UNSUPPORTED_OPERATION;
 }
 
+//2024: Same as " %.8f" without printf.
+template<class T>
+static DataDest &iqefilter_floats(DataDest &dst, int n, const T *f)
+{
+	for(int i=0;i<n;i++) dst.text(' ').text(f[i],8); return dst;
+}
+
 // TODO: Support using a file for bone order list like the Blender IQE exporter?
 Model::ModelErrorE IqeFilter::writeFile(Model *model, const char *const filename, Options &o)
 {
@@ -157,9 +164,9 @@ Model::ModelErrorE IqeFilter::writeFile(Model *model, const char *const filename
 			rot[2] = -rot[2];
 			rot[3] = -rot[3];
 
-			writeLine(dst,"\tpq %.8f %.8f %.8f %.8f %.8f %.8f %.8f",
-							(float)trans[0],(float)trans[1],(float)trans[2],
-							(float)rot[0],(float)rot[1],(float)rot[2],(float)rot[3]);
+			float v[7] = {(float)trans[0],(float)trans[1],(float)trans[2],
+				(float)rot[0],(float)rot[1],(float)rot[2],(float)rot[3]};
+			iqefilter_floats(dst->text("\tpq"),7,v).textLine();
 			//writeLine(dst,"\tpm %.8f %.8f %.8f %.8f %.8f %.8f %.8f %.8f %.8f %.8f %.8f %.8f",
 			//			  (float)trans[0],(float)trans[1],(float)trans[2],
 			//			  (float)lm.get(0,0),(float)lm.get(0,1),(float)lm.get(0,2),
@@ -210,9 +217,9 @@ Model::ModelErrorE IqeFilter::writeFile(Model *model, const char *const filename
 			rot[2] = -rot[2];
 			rot[3] = -rot[3];
 
-			writeLine(dst,"\tpq %.8f %.8f %.8f %.8f %.8f %.8f %.8f",
-							(float)trans[0],(float)trans[1],(float)trans[2],
-							(float)rot[0],(float)rot[1],(float)rot[2],(float)rot[3]);
+			float v[7] = {(float)trans[0],(float)trans[1],(float)trans[2],
+				(float)rot[0],(float)rot[1],(float)rot[2],(float)rot[3]};
+			iqefilter_floats(dst->text("\tpq"),7,v).textLine();
 			//writeLine(dst,"\tpm %.8f %.8f %.8f %.8f %.8f %.8f %.8f %.8f %.8f %.8f %.8f %.8f",
 			//			  (float)trans[0],(float)trans[1],(float)trans[2],
 			//			  (float)lm.get(0,0),(float)lm.get(0,1),(float)lm.get(0,2),
@@ -283,9 +290,11 @@ Model::ModelErrorE IqeFilter::writeFile(Model *model, const char *const filename
 					saveMatrix.apply4(meshVec);
 					saveMatrix.apply4(meshNor);
 
-					writeLine(dst,"vp %.8f %.8f %.8f",(float)meshVec[0],(float)meshVec[1],(float)meshVec[2]);
-					writeLine(dst,"\tvt %.8f %.8f",(*vit).uv[0],(float)(1.0f-(*vit).uv[1]));
-					writeLine(dst,"\tvn %.8f %.8f %.8f",meshNor[0],meshNor[1],meshNor[2]);
+					float vp[3] = {(float)meshVec[0],(float)meshVec[1],(float)meshVec[2]};
+					float vt[2] = {(*vit).uv[0],1.0f-(*vit).uv[1]};
+					iqefilter_floats(dst->text("vp"),3,vp).textLine();
+					iqefilter_floats(dst->text("\tvt"),2,vt).textLine();
+					iqefilter_floats(dst->text("\tvn"),3,meshNor).textLine();
 
 					if(m_options->m_saveSkeleton&&boneCount>0)
 					{
@@ -311,7 +320,7 @@ Model::ModelErrorE IqeFilter::writeFile(Model *model, const char *const filename
 						}
 
 						// Write out influence list
-						dst->writePrintf("\tvb");
+						dst->text("\tvb");
 						for(it = il.begin(); it!=il.end(); it++)
 						{
 							double weight = (it->m_weight/total);
@@ -321,9 +330,10 @@ Model::ModelErrorE IqeFilter::writeFile(Model *model, const char *const filename
 								break;
 							}
 
-							dst->writePrintf(" %d %.8f",it->m_boneId,(float)weight);
+							dst->text(' ').text(it->m_boneId);
+							dst->text(' ').text((float)weight,8);
 						}
-						dst->writePrintf("\r\n");
+						dst->textLine();
 					}
 				}
 
@@ -337,7 +347,9 @@ Model::ModelErrorE IqeFilter::writeFile(Model *model, const char *const filename
 				for(fit = (*mlit).faces.begin(); fit!=(*mlit).faces.end(); fit++)
 				{
 					// Quake-like engines use reverse triangle winding order (glCullFace GL_FRONT)
-					writeLine(dst,"fm %d %d %d",(*fit).v[2],(*fit).v[1],(*fit).v[0]);
+					dst->text("fm");
+					for(int i=3;i-->0;) dst->text(' ').text((*fit).v[i]);
+					dst->textLine();
 				}
 
 				writeLine(dst,"");
@@ -420,9 +432,9 @@ Model::ModelErrorE IqeFilter::writeFile(Model *model, const char *const filename
 					rot[2] = -rot[2];
 					rot[3] = -rot[3];
 
-					writeLine(dst,"pq %.8f %.8f %.8f %.8f %.8f %.8f %.8f",
-											(float)trans[0],(float)trans[1],(float)trans[2],
-											(float)rot[0],(float)rot[1],(float)rot[2],(float)rot[3]);
+					float v[7] = {(float)trans[0],(float)trans[1],(float)trans[2],
+						(float)rot[0],(float)rot[1],(float)rot[2],(float)rot[3]};
+					iqefilter_floats(dst->text("pq"),7,v).textLine();
 					//writeLine(dst,"pm %.8f %.8f %.8f %.8f %.8f %.8f %.8f %.8f %.8f %.8f %.8f %.8f",
 					//			  (float)trans[0],(float)trans[1],(float)trans[2],
 					//			  (float)lm.get(0,0),(float)lm.get(0,1),(float)lm.get(0,2),
@@ -465,9 +477,9 @@ Model::ModelErrorE IqeFilter::writeFile(Model *model, const char *const filename
 						rot[2] = -rot[2];
 						rot[3] = -rot[3];
 
-						writeLine(dst,"pq %.8f %.8f %.8f %.8f %.8f %.8f %.8f",
-										(float)trans[0],(float)trans[1],(float)trans[2],
-										(float)rot[0],(float)rot[1],(float)rot[2],(float)rot[3]);
+						float v[7] = {(float)trans[0],(float)trans[1],(float)trans[2],
+							(float)rot[0],(float)rot[1],(float)rot[2],(float)rot[3]};
+						iqefilter_floats(dst->text("pq"),7,v).textLine();
 						//writeLine(dst,"pm %.8f %.8f %.8f %.8f %.8f %.8f %.8f %.8f %.8f %.8f %.8f %.8f",
 						//			  (float)trans[0],(float)trans[1],(float)trans[2],
 						//			  (float)lm.get(0,0),(float)lm.get(0,1),(float)lm.get(0,2),
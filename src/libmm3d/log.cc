@@ -22,6 +22,10 @@
 
 #include "mm3dtypes.h" //PCH
 
+#include <chrono> //2024
+#include <mutex> //2024
+#include <thread> //2024
+
 #include "log.h"
 
 #ifdef CODE_DEBUG
@@ -107,25 +111,212 @@ void log_error(const char *fmt,...)
 	}
 }
 
-#ifdef __DO_PROFILE
+std::atomic<bool> log_profile_on(false); //2024
 
-static FILE *log_logProfileFP = nullptr;
+enum{ log_profile_ring_size=1<<16, log_profile_bins=32 };
 
-void log_profile_init(const char *filename)
+struct log_profile_event_t
 {
-	if(log_logProfileFP==nullptr)
+	const char *str; long long start,end;
+};
+struct log_profile_stats_t
+{
+	long long count,total,min,max;
+
+	long long hist[log_profile_bins]; //log2 of microseconds
+
+	void add(long long ns)
+	{
+		if(!count++) min = max = ns;
+		else{ min = std::min(min,ns); max = std::max(max,ns); }
+		total+=ns;
+		int bin = 0; 
+		for(long long us=ns/1000;us&&bin<log_profile_bins-1;us>>=1) bin++;
+		hist[bin]++;
+	}
+	void add(const log_profile_stats_t &cmp)
+	{
+		if(!cmp.count) return;
+		if(!count){ *this = cmp; return; }
+		count+=cmp.count; total+=cmp.total;
+		min = std::min(min,cmp.min); max = std::max(max,cmp.max);
+		for(int i=log_profile_bins;i-->0;) hist[i]+=cmp.hist[i];
+	}
+};
+//Only the thread that owns a ring writes to it. When the ring wraps
+//the event that is overwritten is added to the totals first, so the
+//totals are complete even though the trace keeps the latest events.
+struct log_profile_ring
+{
+	int tid;
+
+	std::vector<log_profile_event_t> events;
+
+	std::atomic<size_t> head;
+
+	//Set while the owner writes (see log_profile_shutdown.)
+	std::atomic<bool> busy;
+
+	std::unordered_map<const char*,log_profile_stats_t> stats;
+
+	const char *last_str = nullptr; log_profile_stats_t *last;
+
+	void fold(const log_profile_event_t &e)
 	{
-		log_logProfileFP = fopen(filename,"w");
+		if(e.str!=last_str) //Usually the same scope repeats.
+		{
+			last = &stats[e.str]; last_str = e.str;
+		}
+		last->add(e.end-e.start);
 	}
+};
+static std::string log_profile_filename;
+static long long log_profile_t0 = 0;
+//Guards log_profile_rings when a thread makes its ring, but
+//not recording. The rings outlive their threads, and aren't
+//deleted by log_profile_shutdown since log_profile_tl still
+//points to them. Scopes that end after that are dropped.
+static std::mutex log_profile_mutex;
+static std::vector<log_profile_ring*> log_profile_rings;
+static thread_local log_profile_ring *log_profile_tl = nullptr;
+
+long long log_profile_ns()
+{
+	using namespace std::chrono;
+	return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
 }
+void log_profile_event(const char *str, long long start, long long end)
+{
+	if(!log_profile_on.load(std::memory_order_relaxed)) return;
 
-void log_profile_shutdown()
+	auto *r = log_profile_tl; if(!r)
+	{
+		r = log_profile_tl = new log_profile_ring;
+		r->events.resize(log_profile_ring_size);
+		r->head = 0; r->busy = false;
+
+		std::lock_guard<std::mutex> lock(log_profile_mutex);
+		r->tid = (int)log_profile_rings.size()+1;
+		log_profile_rings.push_back(r);
+	}
+
+	//Either this sees log_profile_on is off or shutdown sees busy.
+	r->busy.store(true);
+	if(!log_profile_on.load())
+	{
+		r->busy.store(false,std::memory_order_release); return;
+	}
+
+	size_t h = r->head.load(std::memory_order_relaxed);
+
+	auto &e = r->events[h&(log_profile_ring_size-1)];
+
+	if(h>=log_profile_ring_size) r->fold(e);
+
+	e.str = str; e.start = start; e.end = end;
+
+	r->head.store(h+1,std::memory_order_relaxed);
+
+	r->busy.store(false,std::memory_order_release);
+}
+
+void log_profile_enable(bool o)
 {
-	if(log_logProfileFP)
+	if(o&&!log_profile_t0) log_profile_t0 = log_profile_ns();
+
+	log_profile_on = o;
+}
+static bool log_profile_overwritable(const char *filename)
+{
+	//Only replace an empty file or an earlier trace, in case the
+	//filename is really a model (e.g. "--profile model.mm3d".)
+	FILE *fp = fopen(filename,"rb"); if(!fp) return true;
+	char buf[16] = {}; size_t n = fread(buf,1,sizeof(buf),fp);
+	fclose(fp);
+	return !n||!memcmp(buf,"{\"displayTimeUnit",n);
+}
+void log_profile_init(const char *filename)
+{
+	if(filename&&*filename)
 	{
-		fclose(log_logProfileFP);
-		log_logProfileFP = nullptr;
+		if(log_profile_overwritable(filename))
+		{
+			log_profile_filename = filename;
+		}
+		else fprintf(stderr,"profile: Not writing to %s (it's not a trace)\n",filename);
 	}
+
+	log_profile_enable(true);
 }
+void log_profile_shutdown()
+{
+	log_profile_on = false;
+
+	std::lock_guard<std::mutex> lock(log_profile_mutex);
+
+	if(log_profile_rings.empty()) return;
 
-#endif // __DO_PROFILE
+	//Wait for events that began before log_profile_on was cleared.
+	for(auto*r:log_profile_rings)
+	while(r->busy.load(std::memory_order_acquire))
+	std::this_thread::yield();
+
+	FILE *fp = nullptr; 
+	if(!log_profile_filename.empty())
+	{
+		if(log_profile_overwritable(log_profile_filename.c_str()))
+		fp = fopen(log_profile_filename.c_str(),"w");
+		if(!fp) log_error("Could not write profile to %s\n",log_profile_filename.c_str());
+	}
+	if(fp) fprintf(fp,"{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+
+	const char *comma = "";
+	std::map<std::string,log_profile_stats_t> totals;
+	for(auto*r:log_profile_rings)
+	{
+		size_t h = r->head.load(std::memory_order_acquire);
+		size_t i = h>log_profile_ring_size?h-log_profile_ring_size:0;
+		for(;i<h;i++)
+		{
+			auto &e = r->events[i&(log_profile_ring_size-1)]; r->fold(e);
+
+			if(fp)
+			{
+				fprintf(fp,"%s{\"name\":\"",comma); comma = ",\n";
+				for(const char*c=e.str;*c;c++)
+				{
+					if(*c=='"'||*c=='\\') fputc('\\',fp); fputc(*c,fp);
+				}
+				fprintf(fp,"\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+				r->tid,(e.start-log_profile_t0)/1000.0,(e.end-e.start)/1000.0);
+			}
+		}
+		for(auto&ea:r->stats) totals[ea.first].add(ea.second);
+
+		//Reset instead of delete (see log_profile_tl.)
+		r->stats.clear(); r->last_str = nullptr;
+		r->head.store(0,std::memory_order_relaxed);
+	}
+
+	if(fp){ fprintf(fp,"\n]}\n"); fclose(fp); }
+
+	std::vector<std::pair<std::string,log_profile_stats_t>> l(totals.begin(),totals.end());
+	std::sort(l.begin(),l.end(),[](auto &a, auto &b)
+	{
+		return a.second.total>b.second.total;
+	});
+	fprintf(stderr,"profile:  %10s %12s %12s %12s %12s  scope\n","count","total ms","mean us","min us","max us");
+	for(auto&ea:l)
+	{
+		auto &st = ea.second;
+		fprintf(stderr,"profile:  %10lld %12.3f %12.3f %12.3f %12.3f  %s\n",
+		st.count,st.total/1e6,st.total/1e3/st.count,st.min/1e3,st.max/1e3,ea.first.c_str());
+		fprintf(stderr,"          ");
+		for(int i=0;i<log_profile_bins;i++) if(st.hist[i])
+		{
+			if(i) fprintf(stderr," <%lldus:%lld",1ll<<i,st.hist[i]);
+			else fprintf(stderr," <1us:%lld",st.hist[i]);
+		}
+		fprintf(stderr,"\n");
+	}
+}
@@ -36,55 +36,46 @@ extern void log_warning(const char *fmt,...);
 extern void log_error(const char *fmt,...);
 extern void log_output(const char *fmt,...);
 
-#ifdef __DO_PROFILE
-
-#include <sys/timeb.h> //???
+//2024: LOG_PROFILE is always compiled in. Until log_profile_enable
+//turns it on (see --profile) it costs a relaxed load. When it's on
+//each scope is recorded into a ring buffer owned by the thread (no
+//locks) with steady_clock nanoseconds. log_profile_shutdown writes
+//the events as Chrome trace JSON (chrome://tracing or Perfetto) if
+//log_profile_init gave a filename, and prints per-scope histograms.
+//log_profile_init won't overwrite a file that isn't a trace.
+extern std::atomic<bool> log_profile_on;
+
+extern void log_profile_init(const char *filename); //enables
+extern void log_profile_enable(bool o);
+extern void log_profile_shutdown();
 
-extern FILE *_logProfileFP;
+extern long long log_profile_ns();
+extern void log_profile_event(const char *str, long long start, long long end);
 
 class LogProfileObject
 {
 	public:
 		inline LogProfileObject(const char *str)
-			: m_str(str)
 		{
-			if(_logProfileFP)
-			{
-				ftime(&m_startTb);
-				fprintf(_logProfileFP,"IN:  %d.%03d %s\n",(int)m_startTb.time,m_startTb.millitm,str);
-			}
+			m_str = log_profile_on.load(std::memory_order_relaxed)?str:nullptr;
+
+			m_start = m_str?log_profile_ns():0;
 		}
 		inline ~LogProfileObject()
 		{
-			if(_logProfileFP)
-			{
-				struct timeb tb;
-				ftime(&tb);
-				fprintf(_logProfileFP,"OUT: %d.%03d (%d)%s\n",(int)tb.time,tb.millitm,
-						((int)tb.time *1000+tb.millitm)-((int)m_startTb.time *1000+m_startTb.millitm),
-						m_str);
-			}
+			if(m_str) log_profile_event(m_str,m_start,log_profile_ns());
 		}
 
 	private:
-		struct timeb m_startTb;
 		const char *m_str;
+		long long m_start;
 };
 
-extern void log_profile_init(const char *filename);
-extern void log_profile_shutdown();
-
+#ifdef _MSC_VER
+#define LOG_PROFILE()LogProfileObject _profileObj(__FUNCSIG__);
+#else
 #define LOG_PROFILE()LogProfileObject _profileObj(__PRETTY_FUNCTION__);
+#endif
 #define LOG_PROFILE_STR(x)LogProfileObject _profileObj((x));
 
-#else
-
-#define LOG_PROFILE()
-#define LOG_PROFILE_STR(x)
-
-#define log_profile_init(x)
-#define log_profile_shutdown()
-
-#endif // __DO_PROFILE
-
 #endif // __LOG_H
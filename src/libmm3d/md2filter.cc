@@ -57,6 +57,7 @@ protected:
 #include "mm3dport.h"
 #include "datasource.h"
 #include "datadest.h"
+#include "anorms.h"
   
 //2019: No other files use this class. It can be made public
 //if it needs to be shared.
@@ -97,7 +98,7 @@ public:
 
 	virtual TriPrimTypeE getNextPrimitive(TriangleVertexList &tvl)= 0;
 
-	static void registerTriPrimFunction(NewTriPrimFunc newFunc); //UNUSED
+	static void registerTriPrimFunction(NewTriPrimFunc newFunc);
 
 	static TriPrim *newTriPrim()
 	{
@@ -147,178 +148,138 @@ protected:
 
 	Model *m_model; int m_triNumber;
 };
+//2024: Greedy strips. Each strip starts from the unused triangle with 
+//the fewest neighbors and grows across shared edges for as long as it
+//can. Triangles are neighbors if they share an edge in opposite order
+//with matching texture coordinates (and texture if grouped) so strips
+//don't cross UV seams.
+class StripTriPrim : public TriPrim
+{
+public:
+
+	bool findPrimitives(Model *model, bool grouped = true)
+	{
+		auto &vl = model->getVertexList();
+		auto &tl = model->getTriangleList();
+		unsigned tcount = tl.size();
+
+		m_strips.clear(); m_verts.clear(); m_strip = m_vert = 0;
+
+		for(unsigned t=0;t<tcount;t++) tl[t]->m_user = t;
+
+		auto tex = [&](const Model::Triangle *tp)
+		{
+			return tp->m_group<0?-1:model->getGroupTextureId(tp->m_group);
+		};
+
+		//Neighbor triangle across each edge (v[e] to v[e+1]) and its
+		//edge index. -1 if there isn't one.
+		std::vector<int> nt(tcount*3,-1);
+		std::vector<int> ne(tcount*3);
+		std::vector<unsigned> order(tcount);
+		std::vector<int> degree(tcount);
+		for(unsigned t=0;t<tcount;t++)
+		{
+			auto *tp = tl[t]; auto *v = tp->m_vertexIndices;
+
+			for(int e=0;e<3;e++)
+			{
+				int e2 = (e+1)%3;
+
+				for(auto&f:vl[v[e2]]->m_faces)
+				{
+					auto *tp2 = f.first; int c = f.second, c2 = (c+1)%3;
+
+					if(tp2==tp||tp2->m_vertexIndices[c2]!=v[e]) continue;
+
+					if(tp2->m_s[c]!=tp->m_s[e2]||tp2->m_t[c]!=tp->m_t[e2]
+					 ||tp2->m_s[c2]!=tp->m_s[e]||tp2->m_t[c2]!=tp->m_t[e]) continue;
+
+					if(grouped&&tex(tp2)!=tex(tp)) continue;
+
+					nt[t*3+e] = tp2->m_user; ne[t*3+e] = c; 
+					
+					degree[t]++; break;
+				}
+			}
+			order[t] = t;
+		}
+		std::stable_sort(order.begin(),order.end(),[&](unsigned a, unsigned b)
+		{
+			return degree[a]<degree[b];
+		});
+
+		//Each start is tried with each edge first and the longest of
+		//the three is kept. stamp marks triangles used by the attempt.
+		std::vector<unsigned> stamp(tcount,0); unsigned attempt = 0;
+		std::vector<bool> used(tcount);
+		auto grow = [&](unsigned t, int r, bool commit)->size_t
+		{
+			attempt++;
+			size_t n = 1; bool odd = false;
+			if(commit) for(int i=0;i<3;i++) add(tl[t],(r+i)%3);
+			for(int eo=(r+1)%3;;)
+			{
+				stamp[t] = attempt; if(commit) used[t] = true;
+				int t2 = nt[t*3+eo], j = ne[t*3+eo];
+				if(t2<0||used[t2]||stamp[t2]==attempt) break;
+				t = t2; odd = !odd; n++;
+				if(commit) add(tl[t],(j+2)%3);
+				eo = (j+(odd?2:1))%3;
+			}
+			return n;
+		};
+		for(unsigned t:order) if(!used[t])
+		{
+			int best = 0; size_t len = 0;
+			for(int r=0;r<3;r++)
+			{
+				size_t n = grow(t,r,false); if(n>len)
+				{
+					len = n; best = r;
+				}
+			}
+			size_t first = m_verts.size();
+			grow(t,best,true);
+			m_strips.push_back(m_verts.size()-first);
+		}
+
+		//log_debug("%d strips,%f triangles per strip\n",m_strips.size(),(double)tcount/m_strips.size());
+
+		return true;
+	}
+
+	void resetList(){ m_strip = 0; m_vert = 0; }; // Reset to start of list
+
+	TriPrimTypeE getNextPrimitive(TriangleVertexList &tvl)
+	{
+		if(m_strip>=m_strips.size()) return TRI_PRIM_NONE;
+
+		auto *first = m_verts.data()+m_vert;
+		tvl.assign(first,first+m_strips[m_strip]);
+		m_vert+=m_strips[m_strip++];
+		return TRI_PRIM_STRIP;
+	}
+
+protected:
+
+	void add(const Model::Triangle *tp, int i)
+	{
+		m_verts.push_back({(int)tp->m_vertexIndices[i],tp->m_s[i],tp->m_t[i]});
+	}
+
+	std::vector<size_t> m_strips; size_t m_strip = 0;
+	TriangleVertexList m_verts; size_t m_vert = 0;
+};
 static TriPrim *md2filter_newSimpleTriPrimFunc(){ return new SimpleTriPrim(); }
-TriPrim::NewTriPrimFunc TriPrim::s_newFunc = md2filter_newSimpleTriPrimFunc;
+static TriPrim *md2filter_newStripTriPrimFunc(){ return new StripTriPrim(); }
+//2024: Strips are the default (registerTriPrimFunction is unused.)
+TriPrim::NewTriPrimFunc TriPrim::s_newFunc = md2filter_newStripTriPrimFunc;
 void TriPrim::registerTriPrimFunction(NewTriPrimFunc newFunc) 
 {
 	s_newFunc = newFunc?newFunc:md2filter_newSimpleTriPrimFunc;
 }
 
-const unsigned MAX_QUAKE_NORMALS = 162;
-static float s_quakeNormals[MAX_QUAKE_NORMALS][3] = 
-{{-0.525731f,0.000000f,0.850651f},
-{-0.442863f,0.238856f,0.864188f},
-{-0.295242f,0.000000f,0.955423f},
-{-0.309017f,0.500000f,0.809017f},
-{-0.162460f,0.262866f,0.951056f},
-{0.000000f,0.000000f,1.000000f},
-{0.000000f,0.850651f,0.525731f},
-{-0.147621f,0.716567f,0.681718f},
-{0.147621f,0.716567f,0.681718f},
-{0.000000f,0.525731f,0.850651f},
-{0.309017f,0.500000f,0.809017f},
-{0.525731f,0.000000f,0.850651f},
-{0.295242f,0.000000f,0.955423f},
-{0.442863f,0.238856f,0.864188f},
-{0.162460f,0.262866f,0.951056f},
-{-0.681718f,0.147621f,0.716567f},
-{-0.809017f,0.309017f,0.500000f},
-{-0.587785f,0.425325f,0.688191f},
-{-0.850651f,0.525731f,0.000000f},
-{-0.864188f,0.442863f,0.238856f},
-{-0.716567f,0.681718f,0.147621f},
-{-0.688191f,0.587785f,0.425325f},
-{-0.500000f,0.809017f,0.309017f},
-{-0.238856f,0.864188f,0.442863f},
-{-0.425325f,0.688191f,0.587785f},
-{-0.716567f,0.681718f,-0.147621f},
-{-0.500000f,0.809017f,-0.309017f},
-{-0.525731f,0.850651f,0.000000f},
-{0.000000f,0.850651f,-0.525731f},
-{-0.238856f,0.864188f,-0.442863f},
-{0.000000f,0.955423f,-0.295242f},
-{-0.262866f,0.951056f,-0.162460f},
-{0.000000f,1.000000f,0.000000f},
-{0.000000f,0.955423f,0.295242f},
-{-0.262866f,0.951056f,0.162460f},
-{0.238856f,0.864188f,0.442863f},
-{0.262866f,0.951056f,0.162460f},
-{0.500000f,0.809017f,0.309017f},
-{0.238856f,0.864188f,-0.442863f},
-{0.262866f,0.951056f,-0.162460f},
-{0.500000f,0.809017f,-0.309017f},
-{0.850651f,0.525731f,0.000000f},
-{0.716567f,0.681718f,0.147621f},
-{0.716567f,0.681718f,-0.147621f},
-{0.525731f,0.850651f,0.000000f},
-{0.425325f,0.688191f,0.587785f},
-{0.864188f,0.442863f,0.238856f},
-{0.688191f,0.587785f,0.425325f},
-{0.809017f,0.309017f,0.500000f},
-{0.681718f,0.147621f,0.716567f},
-{0.587785f,0.425325f,0.688191f},
-{0.955423f,0.295242f,0.000000f},
-{1.000000f,0.000000f,0.000000f},
-{0.951056f,0.162460f,0.262866f},
-{0.850651f,-0.525731f,0.000000f},
-{0.955423f,-0.295242f,0.000000f},
-{0.864188f,-0.442863f,0.238856f},
-{0.951056f,-0.162460f,0.262866f},
-{0.809017f,-0.309017f,0.500000f},
-{0.681718f,-0.147621f,0.716567f},
-{0.850651f,0.000000f,0.525731f},
-{0.864188f,0.442863f,-0.238856f},
-{0.809017f,0.309017f,-0.500000f},
-{0.951056f,0.162460f,-0.262866f},
-{0.525731f,0.000000f,-0.850651f},
-{0.681718f,0.147621f,-0.716567f},
-{0.681718f,-0.147621f,-0.716567f},
-{0.850651f,0.000000f,-0.525731f},
-{0.809017f,-0.309017f,-0.500000f},
-{0.864188f,-0.442863f,-0.238856f},
-{0.951056f,-0.162460f,-0.262866f},
-{0.147621f,0.716567f,-0.681718f},
-{0.309017f,0.500000f,-0.809017f},
-{0.425325f,0.688191f,-0.587785f},
-{0.442863f,0.238856f,-0.864188f},
-{0.587785f,0.425325f,-0.688191f},
-{0.688191f,0.587785f,-0.425325f},
-{-0.147621f,0.716567f,-0.681718f},
-{-0.309017f,0.500000f,-0.809017f},
-{0.000000f,0.525731f,-0.850651f},
-{-0.525731f,0.000000f,-0.850651f},
-{-0.442863f,0.238856f,-0.864188f},
-{-0.295242f,0.000000f,-0.955423f},
-{-0.162460f,0.262866f,-0.951056f},
-{0.000000f,0.000000f,-1.000000f},
-{0.295242f,0.000000f,-0.955423f},
-{0.162460f,0.262866f,-0.951056f},
-{-0.442863f,-0.238856f,-0.864188f},
-{-0.309017f,-0.500000f,-0.809017f},
-{-0.162460f,-0.262866f,-0.951056f},
-{0.000000f,-0.850651f,-0.525731f},
-{-0.147621f,-0.716567f,-0.681718f},
-{0.147621f,-0.716567f,-0.681718f},
-{0.000000f,-0.525731f,-0.850651f},
-{0.309017f,-0.500000f,-0.809017f},
-{0.442863f,-0.238856f,-0.864188f},
-{0.162460f,-0.262866f,-0.951056f},
-{0.238856f,-0.864188f,-0.442863f},
-{0.500000f,-0.809017f,-0.309017f},
-{0.425325f,-0.688191f,-0.587785f},
-{0.716567f,-0.681718f,-0.147621f},
-{0.688191f,-0.587785f,-0.425325f},
-{0.587785f,-0.425325f,-0.688191f},
-{0.000000f,-0.955423f,-0.295242f},
-{0.000000f,-1.000000f,0.000000f},
-{0.262866f,-0.951056f,-0.162460f},
-{0.000000f,-0.850651f,0.525731f},
-{0.000000f,-0.955423f,0.295242f},
-{0.238856f,-0.864188f,0.442863f},
-{0.262866f,-0.951056f,0.162460f},
-{0.500000f,-0.809017f,0.309017f},
-{0.716567f,-0.681718f,0.147621f},
-{0.525731f,-0.850651f,0.000000f},
-{-0.238856f,-0.864188f,-0.442863f},
-{-0.500000f,-0.809017f,-0.309017f},
-{-0.262866f,-0.951056f,-0.162460f},
-{-0.850651f,-0.525731f,0.000000f},
-{-0.716567f,-0.681718f,-0.147621f},
-{-0.716567f,-0.681718f,0.147621f},
-{-0.525731f,-0.850651f,0.000000f},
-{-0.500000f,-0.809017f,0.309017f},
-{-0.238856f,-0.864188f,0.442863f},
-{-0.262866f,-0.951056f,0.162460f},
-{-0.864188f,-0.442863f,0.238856f},
-{-0.809017f,-0.309017f,0.500000f},
-{-0.688191f,-0.587785f,0.425325f},
-{-0.681718f,-0.147621f,0.716567f},
-{-0.442863f,-0.238856f,0.864188f},
-{-0.587785f,-0.425325f,0.688191f},
-{-0.309017f,-0.500000f,0.809017f},
-{-0.147621f,-0.716567f,0.681718f},
-{-0.425325f,-0.688191f,0.587785f},
-{-0.162460f,-0.262866f,0.951056f},
-{0.442863f,-0.238856f,0.864188f},
-{0.162460f,-0.262866f,0.951056f},
-{0.309017f,-0.500000f,0.809017f},
-{0.147621f,-0.716567f,0.681718f},
-{0.000000f,-0.525731f,0.850651f},
-{0.425325f,-0.688191f,0.587785f},
-{0.587785f,-0.425325f,0.688191f},
-{0.688191f,-0.587785f,0.425325f},
-{-0.955423f,0.295242f,0.000000f},
-{-0.951056f,0.162460f,0.262866f},
-{-1.000000f,0.000000f,0.000000f},
-{-0.850651f,0.000000f,0.525731f},
-{-0.955423f,-0.295242f,0.000000f},
-{-0.951056f,-0.162460f,0.262866f},
-{-0.864188f,0.442863f,-0.238856f},
-{-0.951056f,0.162460f,-0.262866f},
-{-0.809017f,0.309017f,-0.500000f},
-{-0.864188f,-0.442863f,-0.238856f},
-{-0.951056f,-0.162460f,-0.262866f},
-{-0.809017f,-0.309017f,-0.500000f},
-{-0.681718f,0.147621f,-0.716567f},
-{-0.681718f,-0.147621f,-0.716567f},
-{-0.850651f,0.000000f,-0.525731f},
-{-0.688191f,0.587785f,-0.425325f},
-{-0.587785f,0.425325f,-0.688191f},
-{-0.425325f,0.688191f,-0.587785f},
-{-0.425325f,-0.688191f,-0.587785f},
-{-0.587785f,-0.425325f,-0.688191f},
-{-0.688191f,-0.587785f,-0.425325f}};
-
 static void md2filter_invertModelNormals(Model *model)
 {
 	size_t tcount = model->getTriangleCount();
@@ -328,30 +289,6 @@ static void md2filter_invertModelNormals(Model *model)
 	}
 }
 
-static unsigned bestNormal(float *norm)
-{
-	float bestDistance = 10000; //3 should do it?
-	unsigned bestIndex = 0;
-
-	for(unsigned t = 0; t<MAX_QUAKE_NORMALS; t++)
-	{
-		float x = norm[0]-s_quakeNormals[t][0];
-		float y = norm[1]-s_quakeNormals[t][1];
-		float z = norm[2]-s_quakeNormals[t][2];
-
-		//float distance = sqrt(x*x+y*y+z*z);
-		float distance = x*x+y*y+z*z;
-
-		if(distance<bestDistance)
-		{
-			bestIndex = t;
-			bestDistance = distance;
-		}
-	}
-
-	return bestIndex;
-}
-
 struct md2filter_TexCoordT{ float s,t; };
 
 Md2Filter::Md2Filter()
@@ -456,7 +393,6 @@ Model::ModelErrorE Md2Filter::readFile(Model *model, const char *const filename)
 
 	int32_t i;
 	unsigned t;
-	unsigned vertex;
 
 	int animIndex = -1;
 	m_lastAnimIndex = -1;
@@ -479,6 +415,7 @@ Model::ModelErrorE Md2Filter::readFile(Model *model, const char *const filename)
 
 	src->readBytes(name,16);
 
+	std::vector<double> coords(std::max(0,numVertices)*3); //2024
 	for(i = 0; i<numVertices; i++)
 	{
 		uint8_t coord[3];
@@ -489,17 +426,13 @@ Model::ModelErrorE Md2Filter::readFile(Model *model, const char *const filename)
 		}
 		src->read(normal);
 
-		double vec[3];
+		double *vec = &coords[i*3];
 		vec[0] = coord[0] *scale[0]+translate[0];
 		vec[1] = coord[1] *scale[1]+translate[1];
 		vec[2] = coord[2] *scale[2]+translate[2];
 		loadMatrix.apply3(vec);
-
-		vertex = model->addVertex(
-				vec[0],
-				vec[1],
-				vec[2]);
 	}
+	model->addVertices(coords.size()/3,coords.data());
 
 	// Now read all frames to get animation vertices
 	src->seek(offsetFrames);
@@ -590,6 +523,11 @@ Model::ModelErrorE Md2Filter::readFile(Model *model, const char *const filename)
 	// Now read triangles
 	src->seek(offsetTriangles);
 
+	//2024: Triangles are added all at once. Ones with bad indices are
+	//dropped, as addTriangle did.
+	std::vector<unsigned> indices; std::vector<float> st;
+	indices.reserve(std::max(0,numTriangles)*3);
+	st.reserve(std::max(0,numTriangles)*6);
 	for(i = 0; i<numTriangles; i++)
 	{
 		uint16_t vertexIndices[3];
@@ -597,18 +535,25 @@ Model::ModelErrorE Md2Filter::readFile(Model *model, const char *const filename)
 
 		for(t = 0; t<3; t++)
 			src->read(vertexIndices[t]);
+		for(t = 0; t<3; t++)
+			src->read(textureIndices[t]);
 
-		model->addTriangle(vertexIndices[0],vertexIndices[1],vertexIndices[2]);
-		model->addTriangleToGroup(0,i);
+		if(vertexIndices[0]>=numVertices
+		 ||vertexIndices[1]>=numVertices
+		 ||vertexIndices[2]>=numVertices) continue;
 
 		for(t = 0; t<3; t++)
 		{
-			src->read(textureIndices[t]);
-			model->setTextureCoords(i,t,
-					texCoordsList[textureIndices[t]].s,
-					texCoordsList[textureIndices[t]].t);
+			indices.push_back(vertexIndices[t]);
+			st.push_back(texCoordsList[textureIndices[t]].s);
+			st.push_back(texCoordsList[textureIndices[t]].t);
 		}
 	}
+	int tri = model->addTriangles(indices.size()/3,indices.data(),st.data());
+	for(int n=tri;n<(int)model->getTriangleCount();n++)
+	{
+		model->addTriangleToGroup(0,n);
+	}
 
 	// Now read skins
 	src->seek(offsetSkins);
@@ -1063,6 +1008,7 @@ Model::ModelErrorE Md2Filter::writeFile(Model *model, const char *const filename
 	//https://github.com/zturtleman/mm3d/issues/109
 	std::vector<float> vecNormals(3*numVertices);
 	float *avgNormals = vecNormals.data();
+	std::vector<uint8_t> normals(numVertices); //2024
 
 	unsigned anim = noAnim?animCount:0;
 	if(noAnim) goto noAnim; //2021
@@ -1160,15 +1106,6 @@ Model::ModelErrorE Md2Filter::writeFile(Model *model, const char *const filename
 			//double vertNormal[3] = {0,0,0};
 			for(int32_t v=0;v<numVertices;v++)
 			{
-				double vec[3] = {0,0,0};
-				//model->getFrameAnimVertexCoords(anim,i,v,vec[0],vec[1],vec[2]);
-				model->getVertexCoords(v,vec);
-				saveMatrix.apply3(vec);
-				uint8_t xi = (uint8_t)((vec[0]-translate[0])/scale[0]+0.5);
-				uint8_t yi = (uint8_t)((vec[1]-translate[1])/scale[1]+0.5);
-				uint8_t zi = (uint8_t)((vec[2]-translate[2])/scale[2]+0.5);
-				uint8_t normal = 0;
-
 				//https://github.com/zturtleman/mm3d/issues/109
 				//model->getFrameAnimVertexNormal(anim,i,v,vertNormal[0],vertNormal[1],vertNormal[2]);
 				float *vertNormal = avgNormals+v*3; normalize3(vertNormal);
@@ -1179,8 +1116,19 @@ Model::ModelErrorE Md2Filter::writeFile(Model *model, const char *const filename
 				vertNormal[0] = -vertNormal[0];
 				vertNormal[1] = -vertNormal[1];
 				vertNormal[2] = -vertNormal[2];
+			}
+			anorms_quake(numVertices,avgNormals,normals.data()); //2024
 
-				normal = bestNormal(vertNormal);
+			for(int32_t v=0;v<numVertices;v++)
+			{
+				double vec[3] = {0,0,0};
+				//model->getFrameAnimVertexCoords(anim,i,v,vec[0],vec[1],vec[2]);
+				model->getVertexCoords(v,vec);
+				saveMatrix.apply3(vec);
+				uint8_t xi = (uint8_t)((vec[0]-translate[0])/scale[0]+0.5);
+				uint8_t yi = (uint8_t)((vec[1]-translate[1])/scale[1]+0.5);
+				uint8_t zi = (uint8_t)((vec[2]-translate[2])/scale[2]+0.5);
+				uint8_t normal = normals[v];
 
 				dst->write(xi);
 				dst->write(yi);
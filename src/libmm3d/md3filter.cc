@@ -192,6 +192,7 @@ protected:
 #include "mm3dport.h"
 #include "datadest.h"
 #include "datasource.h"
+#include "anorms.h"
 #include "msg.h"
 
 #include "translate.h"
@@ -1052,6 +1053,7 @@ void Md3Filter::readFile_setMeshes(MeshSectionE section, int32_t offsetMeshes, i
 
 			m_meshVecInfos[mesh] = new MeshVectorInfoT[meshVertexCount];
 
+			std::vector<double> coords(meshVertexCount*3); //2024
 			for(int vert = 0; vert<meshVertexCount; vert++)
 			{
 				for(int n = 0; n<3; n ++)
@@ -1064,7 +1066,12 @@ void Md3Filter::readFile_setMeshes(MeshSectionE section, int32_t offsetMeshes, i
 				//log_debug("normals lat,lng: %d,%d\n",m_meshVecInfos[mesh][vert].lat,m_meshVecInfos[mesh][vert].lng);
 
 				loadMatrix.apply4(meshVec);
-				m_meshVecInfos[mesh][vert].id = m_model->addVertex(meshVec[0],meshVec[1],meshVec[2]);
+				for(int n=3;n-->0;) coords[vert*3+n] = meshVec[n];
+			}
+			int v0 = m_model->addVertices(meshVertexCount,coords.data());
+			for(int vert = 0; vert<meshVertexCount; vert++)
+			{
+				m_meshVecInfos[mesh][vert].id = v0+vert;
 			}
 		}
 		else
@@ -1152,23 +1159,31 @@ void Md3Filter::readFile_setMeshes(MeshSectionE section, int32_t offsetMeshes, i
 			//std::vector<int32_t[3]> triang(meshTriangleCount); //C++11
 			std::vector<std::array<int,3>> triang(meshTriangleCount);
 			int_list tri(meshTriangleCount);
+			std::vector<unsigned> indices(meshTriangleCount*3); //2024
 			int32_t groupId = m_model->addGroup(meshName);
+			m_src->readArray(triang.data()->data(),meshTriangleCount*3);
 			for(int t = 0; t<meshTriangleCount; t++)
 			{
 				for(int n = 0; n<3; n++)
 				{
-					triang[t][n] = m_src->readI32();
+					indices[t*3+n] = m_meshVecInfos[mesh][triang[t][2-n]].id;
 				}
-				tri[t]= m_model->addTriangle(m_meshVecInfos[mesh][triang[t][2]].id,m_meshVecInfos[mesh][triang[t][1]].id,m_meshVecInfos[mesh][triang[t][0]].id);
+			}
+			int t0 = m_model->addTriangles(meshTriangleCount,indices.data());
+			for(int t = 0; t<meshTriangleCount; t++)
+			{
+				tri[t] = t0<0?-1:t0+t;
 				m_model->addTriangleToGroup(groupId,tri[t]);
 			}
 
 			//Vertex Texture Coords
 			m_src->seek(meshPos+meshSTOffset);
+			std::vector<float> st(meshVertexCount*2); //2024
+			m_src->readArray(st.data(),st.size());
 			for(int v = 0; v<meshVertexCount; v++)
 			{
-				m_meshVecInfos[mesh][v].s = m_src->readF32();
-				m_meshVecInfos[mesh][v].t = m_src->readF32();
+				m_meshVecInfos[mesh][v].s = st[v*2];
+				m_meshVecInfos[mesh][v].t = st[v*2+1];
 			}
 
 			//Textures/Shaders
@@ -2558,29 +2573,7 @@ Model::ModelErrorE Md3Filter::writeSectionFile(const char *filename,Md3Filter::M
 						m_dst->write((int16_t)(meshVec[0]/MD3_XYZ_SCALE+0.5));
 						m_dst->write((int16_t)(meshVec[1]/MD3_XYZ_SCALE+0.5));
 						m_dst->write((int16_t)(meshVec[2]/MD3_XYZ_SCALE+0.5));
-						int16_t lng;
-						int16_t lat;
-						if(meshNor[0]==0&&meshNor[1]==0)
-						{
-							if(meshNor[2]>0)
-							{
-								lng = 0;
-								lat = 0;
-							}
-							else
-							{
-								lat = 128;
-								lng = 0;
-							}
-						}
-						else
-						{
-							lng = (int16_t)(acos(meshNor[2])*255/(2 *PI));
-							lat = (int16_t)(atan2(meshNor[1],meshNor[0])*255/(2 *PI));
-						}
-						// //log_debug("%f,%f,%f lat %d lng %d\n",meshNor[0],meshNor[1],meshNor[2],lat,lng);
-						uint16_t normal = ((lat &255)*256)| (lng &255);
-						m_dst->write(normal);
+						m_dst->write(anorms_md3(meshNor)); //2024
 					}
 				}			
 			}
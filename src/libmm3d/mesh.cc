@@ -39,6 +39,13 @@ void mesh_create_list(MeshList &meshes,Model *model, int opt)
 		Mesh m;
 		m.clear();
 
+		auto push = [&](Mesh &m)
+		{
+			meshes.push_back(std::move(m));
+			meshes.back().vfirst = {};
+			meshes.back().vnext = {};
+		};
+
 		unsigned int gcount = model->getGroupCount();
 		for(unsigned int g = 0; g<gcount; g++)
 		{
@@ -50,7 +57,7 @@ void mesh_create_list(MeshList &meshes,Model *model, int opt)
 				// or material (if the current one is not empty)
 				if(!m.faces.empty())
 				{
-					meshes.push_back(m);
+					push(m);
 				}
 				m.clear();
 			}
@@ -80,7 +87,7 @@ void mesh_create_list(MeshList &meshes,Model *model, int opt)
 				// or material (if the current one is not empty)
 				if(!m.faces.empty())
 				{
-					meshes.push_back(m);
+					push(m);
 				}
 				m.clear();
 			}
@@ -99,14 +106,14 @@ void mesh_create_list(MeshList &meshes,Model *model, int opt)
 			}
 
 			// ungrouped is not empty,so make sure it gets added to the list
-			meshes.push_back(m);
+			push(m);
 		}
 		else
 		{
 			// Ungrouped is empty,make sure our mesh gets added to the list
 			if(!m.faces.empty())
 			{
-				meshes.push_back(m);
+				push(m);
 			}
 		}
 	}
@@ -118,6 +125,8 @@ void Mesh::clear()
 	group = -1;
 	vertices.clear();
 	faces.clear();
+	vfirst.clear();
+	vnext.clear();
 }
 
 void Mesh::addTriangle(Model *model, int triangle)
@@ -156,10 +165,29 @@ int Mesh::addVertex(Model *model, int triangle, int vertexIndex)
 	for(int j=0;j<3;j++) vert.norm[j] = (float)temp[j];
 	model->getTextureCoords(triangle,vertexIndex,vert.uv[0],vert.uv[1]);
 
-	unsigned int vcount = vertices.size();
-	for(unsigned int index=0;index<vcount;index++)
+	int vcount = (int)vertices.size();
+	if(vnext.size()!=vertices.size())
+	{
+		vfirst.clear(); vnext.assign(vcount,-1);
+		for(int i=vcount;i-->0;)
+		{
+			auto ins = vfirst.emplace(vertices[i].v,i);
+			if(!ins.second)
+			{
+				vnext[i] = ins.first->second; ins.first->second = i;
+			}
+		}
+	}
+
+	//2024: This used to compare every vertex.
+	int *tail = nullptr;
+	auto it = vfirst.find(vert.v);
+	if(it!=vfirst.end()) 
+	for(int index=it->second;index!=-1;index=*tail)
 	{
-		Vertex &cmp = vertices[index]; if(cmp.v==vert.v)
+		tail = &vnext[index];
+
+		Vertex &cmp = vertices[index]; //if(cmp.v==vert.v)
 		{
 			// Yes, I'm using goto to break out of the compare.
 			// Deal with it.
@@ -188,6 +216,9 @@ int Mesh::addVertex(Model *model, int triangle, int vertexIndex)
 		next_vertex:;
 	}
 
+	if(tail) *tail = vcount; else vfirst[vert.v] = vcount;
+	
+	vnext.push_back(-1);
 	vertices.push_back(vert); return vertices.size()-1;
 }
 
@@ -26,6 +26,8 @@
 
 #include "mm3dtypes.h"
 
+#include <unordered_map>
+
 // The Mesh class contains a subset of model data. The purpose is to
 // force model data to conform to some restrictions which do not
 // apply to MM3D models. Examples of this include some model formats
@@ -85,6 +87,13 @@ public:
 	void clear();
 	void addTriangle(Model *m, int triangle);
 	int  addVertex(Model *model, int triangle, int vertexIndex);
+
+	//2024: addVertex uses these to find the vertices of a model
+	//vertex without searching all vertices. Each model vertex's
+	//vertices are chained together in order. mesh_create_list
+	//releases them when a mesh is complete. addVertex rebuilds
+	//them if they're not in sync with "vertices".
+	std::unordered_map<int,int> vfirst; std::vector<int> vnext;
 };
 typedef std::vector<Mesh> MeshList;
 
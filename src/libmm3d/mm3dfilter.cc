@@ -882,6 +882,9 @@ Model::ModelErrorE MisfitFilter::readFile(Model *model, const char *const filena
 			m_src->read(size);
 		}
 
+		//2024: Read the coordinates first to add them all at once.
+		std::vector<uint16_t> vflags(count);
+		std::vector<double> coords(count*3);
 		for(unsigned v=0;v<count;v++)
 		{
 			if(os->variable())
@@ -896,18 +899,25 @@ Model::ModelErrorE MisfitFilter::readFile(Model *model, const char *const filena
 			m_src->read(fileVert.coord[1]);
 			m_src->read(fileVert.coord[2]);
 
-			//vert->m_boneId = -1;
-			model->addVertex(fileVert.coord[0],fileVert.coord[1],fileVert.coord[2]);			
-			auto *vp = modelVerts[v];
+			vflags[v] = fileVert.flags;
+			for(int i=3;i-->0;) coords[v*3+i] = fileVert.coord[i];
+		}
+
+		//vert->m_boneId = -1;
+		unsigned v0 = model->addVertices(count,coords.data());
+		for(unsigned v=0;v<count;v++)
+		{
+			auto flags = vflags[v];
+			auto *vp = modelVerts[v0+v];
 
-			if(MF_SELECTED&fileVert.flags)
+			if(MF_SELECTED&flags)
 			vp->m_selected = true;
-			if(auto l=mm3dfilter_read_layer(fileVert.flags))
+			if(auto l=mm3dfilter_read_layer(flags))
 			vp->hide(l);
-			if(MF_HIDDEN&fileVert.flags)
+			if(MF_HIDDEN&flags)
 			vp->hide();
 			//2020: this should be implicit
-			//if(fileVert.flags&MF_VERTFREE) model->setVertexFree(v,true);
+			//if(flags&MF_VERTFREE) model->setVertexFree(v,true);
 		}
 	}
 	unsigned vcount = modelVerts.size(); //2020
@@ -926,6 +936,8 @@ Model::ModelErrorE MisfitFilter::readFile(Model *model, const char *const filena
 			m_src->read(size);
 		}
 
+		std::vector<uint16_t> tflags(count);
+		std::vector<unsigned> indices(count*3);
 		for(unsigned t=0;t<count;t++)
 		{
 			if(os->variable())
@@ -939,14 +951,26 @@ Model::ModelErrorE MisfitFilter::readFile(Model *model, const char *const filena
 			m_src->read(fileTri.vertex[1]);
 			m_src->read(fileTri.vertex[2]);
 
-			model->addTriangle(fileTri.vertex[0],fileTri.vertex[1],fileTri.vertex[2]);
-			auto *tp = modelTris[t];
+			tflags[t] = fileTri.flags;
+			for(int i=3;i-->0;) indices[t*3+i] = fileTri.vertex[i];
+		}
+
+		int t0 = model->addTriangles(count,indices.data());
+		if(t0<0)
+		{
+			log_error("triangle vertex index out of range\n");
+			return Model::ERROR_BAD_DATA;
+		}
+		for(unsigned t=0;t<count;t++)
+		{
+			auto flags = tflags[t];
+			auto *tp = modelTris[t0+t];
 
-			if(MF_SELECTED&fileTri.flags)
+			if(MF_SELECTED&flags)
 			tp->m_selected = true;
-			if(auto l=mm3dfilter_read_layer(fileTri.flags))
+			if(auto l=mm3dfilter_read_layer(flags))
 			tp->hide(l);
-			if(MF_HIDDEN&fileTri.flags)
+			if(MF_HIDDEN&flags)
 			tp->hide();
 		}
 	}
@@ -2116,7 +2140,7 @@ Model::ModelErrorE MisfitFilter::readFile(Model *model, const char *const filena
 						{
 							//FIX ME
 							//UNSAFE: Need an API for this!
-							modelVerts[v]->m_frames[fp]->m_interp2020 = Model::InterpolateCopy;
+							const_cast<Model::Vertex*>(modelVerts[v])->m_frames[fp].m_interp2020 = Model::InterpolateCopy;
 						}
 						else //InterpolateNone?
 						{
@@ -2378,7 +2402,7 @@ Model::ModelErrorE MisfitFilter::readFile(Model *model, const char *const filena
 						{
 							//FIX ME
 							//UNSAFE: Need an API for this!
-							modelVerts[v]->m_frames[fp]->m_interp2020 = Model::InterpolateCopy;
+							const_cast<Model::Vertex*>(modelVerts[v])->m_frames[fp].m_interp2020 = Model::InterpolateCopy;
 						}
 						else //InterpolateNone?
 						{
@@ -3483,8 +3507,8 @@ Model::ModelErrorE MisfitFilter::writeFile(Model *model, const char *const filen
 				for(unsigned f=0;f<frameCount;f++,fp++)				
 				for(size_t w=0,v=0;v<vcount;)
 				{
-					auto cmp = vdata[v]->m_frames[fp]->m_interp2020;
-					for(w++;w<vcount&&cmp==vdata[w]->m_frames[fp]->m_interp2020;)
+					auto cmp = vdata[v]->m_frames[fp].m_interp2020;
+					for(w++;w<vcount&&cmp==vdata[w]->m_frames[fp].m_interp2020;)
 					w++;
 
 					/*Almost forgot this should be extensible like
@@ -3503,7 +3527,7 @@ Model::ModelErrorE MisfitFilter::writeFile(Model *model, const char *const filen
 					if(cmp>Model::InterpolateCopy) for(;v<w;v++)
 					{
 						//WARNING: This depends on the interpolation model.
-						double *coord = vdata[v]->m_frames[fp]->m_coord;
+						const float *coord = vdata[v]->m_frames[fp].m_coord;
 						for(unsigned i=0;i<3;i++) m_dst->write((float32_t)coord[i]);
 					}
 					else v = w;
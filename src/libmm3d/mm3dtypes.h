@@ -42,6 +42,7 @@ typedef float float32_t;
 #include <memory> 
 #include <unordered_map>
 #include <unordered_set>
+#include <atomic> //2024
 
 #include <math.h>
 #include <limits.h> //INT_MAX
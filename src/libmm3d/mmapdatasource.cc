@@ -0,0 +1,197 @@
+/*  MM3D Misfit/Maverick Model 3D
+ *
+ * Copyright (c)2004-2008 Kevin Worcester
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place-Suite 330, Boston, MA 02111-1307,
+ * USA.
+ *
+ * See the COPYING file for full license text.
+ */
+
+#include "mm3dtypes.h" //PCH
+
+#include "mmapdatasource.h"
+#include "misc.h"
+
+#ifdef _WIN32
+MmapDataSource::MmapDataSource(const char *filename)
+	: m_handle(),m_mapping(),m_map(),m_mapSize()
+{
+	if(filename==nullptr||filename[0]=='\0')
+	{
+		setErrno(EINVAL);
+		return;
+	}
+
+	std::wstring wideString = utf8PathToWide(filename);
+	if(wideString.empty())
+	{
+		setErrno(EINVAL);
+		return;
+	}
+
+	m_handle = CreateFileW(&wideString[0],GENERIC_READ,FILE_SHARE_READ,nullptr,
+								 OPEN_EXISTING,FILE_ATTRIBUTE_NORMAL,nullptr);
+	if(m_handle==INVALID_HANDLE_VALUE||m_handle==nullptr)
+	{
+		m_handle = nullptr;
+
+		if(GetLastError()==ERROR_ACCESS_DENIED)
+		{
+			setErrno(EACCES);
+		}
+		else
+		{
+			setErrno(ENOENT);
+		}
+		return;
+	}
+
+	LARGE_INTEGER length;
+	if(GetFileType(m_handle)!=FILE_TYPE_DISK||!GetFileSizeEx(m_handle,&length)
+	||(ULONGLONG)length.QuadPart>(size_t)-1)
+	{
+		setErrno(EPERM);
+		return;
+	}
+
+	m_mapSize = (size_t)length.QuadPart;
+
+	// CreateFileMapping fails on empty files.
+	if(m_mapSize)
+	{
+		m_mapping = CreateFileMappingW(m_handle,nullptr,PAGE_READONLY,0,0,nullptr);
+		if(m_mapping)
+		m_map = (const uint8_t*)MapViewOfFile(m_mapping,FILE_MAP_READ,0,0,0);
+		if(!m_map)
+		{
+			setErrno(ENOMEM);
+			return;
+		}
+	}
+
+	setFileSize(m_mapSize);
+}
+
+void MmapDataSource::internalClose()
+{
+	if(m_map!=nullptr)
+	{
+		UnmapViewOfFile(m_map);
+		m_map = nullptr;
+	}
+	if(m_mapping!=nullptr)
+	{
+		CloseHandle(m_mapping);
+		m_mapping = nullptr;
+	}
+	if(m_handle!=nullptr)
+	{
+		CloseHandle(m_handle);
+		m_handle = nullptr;
+	}
+}
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
+MmapDataSource::MmapDataSource(const char *filename)
+	: m_map(),m_mapSize()
+{
+	if(filename==nullptr||filename[0]=='\0')
+	{
+		setErrno(EINVAL);
+		return;
+	}
+
+	int fd = open(filename,O_RDONLY);
+	if(fd==-1)
+	{
+		setErrno(errno);
+		return;
+	}
+
+	struct stat st;
+	if(fstat(fd,&st)!=0)
+	{
+		setErrno(errno);
+	}
+	else if(!S_ISREG(st.st_mode))
+	{
+		setErrno(ENODEV);
+	}
+	else
+	{
+		m_mapSize = (size_t)st.st_size;
+	}
+	if(m_mapSize) // mmap fails on empty files.
+	{
+		void *p = mmap(nullptr,m_mapSize,PROT_READ,MAP_PRIVATE,fd,0);
+		if(p!=MAP_FAILED)
+		{
+			m_map = (const uint8_t*)p;
+
+			// Filters mostly read from front to back.
+			posix_madvise(p,m_mapSize,POSIX_MADV_SEQUENTIAL);
+		}
+		else setErrno(errno);
+	}
+
+	// The mapping stays valid after closing.
+	::close(fd);
+
+	if(!errorOccurred()) setFileSize(m_mapSize);
+}
+
+void MmapDataSource::internalClose()
+{
+	if(m_map!=nullptr)
+	{
+		munmap((void*)m_map,m_mapSize);
+		m_map = nullptr;
+	}
+}
+#endif // _WIN32
+
+MmapDataSource::~MmapDataSource()
+{
+	internalClose();
+}
+
+bool MmapDataSource::internalReadAt(off_t offset, const uint8_t ** buf, size_t *bufLen)
+{
+	// TODO should assert on buf and bufLen
+
+	// If we had an error,just keep returning an error
+	if(errorOccurred())
+		return false;
+
+	if((size_t)offset>getFileSize())
+	{
+		setUnexpectedEof(true);
+		return false;
+	}
+	if(!m_map&&getFileSize()) // Closed?
+	{
+		setErrno(EBADF);
+		return false;
+	}
+
+	*buf = m_map+offset;
+	*bufLen = getFileSize()-offset;
+	return true;
+}
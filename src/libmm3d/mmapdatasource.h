@@ -0,0 +1,63 @@
+/*  MM3D Misfit/Maverick Model 3D
+ *
+ * Copyright (c)2004-2008 Kevin Worcester
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place-Suite 330, Boston, MA 02111-1307,
+ * USA.
+ *
+ * See the COPYING file for full license text.
+ */
+
+
+
+#ifndef MMAPDATASOURCE_INC_H__
+#define MMAPDATASOURCE_INC_H__
+
+#include "datasource.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#endif // _WIN32
+
+// This class is a DataSource that maps a file into memory. Reads are
+// made directly from the mapping instead of going through a buffer,
+// so readDirect never fails to return a pointer.
+//
+// It only works for regular files. If the file can't be mapped then
+// errorOccurred is set. FileFactory falls back on FileDataSource in
+// that case.
+
+class MmapDataSource : public DataSource
+{
+	public:
+		MmapDataSource(const char *filename);
+		virtual ~MmapDataSource();
+
+		void internalClose();
+
+	protected:
+		virtual bool internalReadAt(off_t offset, const uint8_t ** buf, size_t *bufLen);
+
+	private:
+
+#ifdef _WIN32
+		HANDLE m_handle,m_mapping;
+#endif // _WIN32
+		const uint8_t *m_map;
+		size_t m_mapSize;
+};
+
+#endif // MMAPDATASOURCE_INC_H__
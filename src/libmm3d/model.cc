@@ -37,6 +37,7 @@
 #include "translate.h"
 
 #include "mm3dport.h"
+#include "parallel.h"
 
 #ifdef MM3D_EDIT
 
@@ -57,8 +58,8 @@ struct NormAngleAccum : NormAccum
 //	double angle;
 };*/
 
-std::string Model::s_lastFilterError = "No error";
-static int model_allocated = 0;
+thread_local std::string Model::s_lastFilterError = "No error";
+static std::atomic<int> model_allocated(0);
 
 const double TOLERANCE = 0.00005;
 const double ATOLERANCE = 0.00000001;
@@ -155,6 +156,8 @@ Model::Model()
 	: m_filename(""),
 	m_validContext(false),
 	  m_validBspTree(false),
+	m_drawArrays(), //2024
+	m_screenIndices(), //2024
 	  m_drawJoints(/*JOINTMODE_BONES*/true),
 	  m_drawSelection(),
 	  m_drawProjections(true),
@@ -217,6 +220,8 @@ Model::Model()
 Model::~Model()
 {
 	m_bspTree.clear();
+	delete m_drawArrays;
+	for(auto*ea:m_screenIndices) delete ea;
 	m_selectedUv.clear();
 
 	//log_debug("deleting model\n");
@@ -364,7 +369,8 @@ bool Model::popError(std::string &rval)
 void Model::updateObservers()
 {
 	//2019: Prevent recursion.
-	static int recursive = 0;
+	//2024: thread_local since --jobs updates models on many threads.
+	static thread_local int recursive = 0;
 
 	//https://github.com/zturtleman/mm3d/issues/90
 	//I'm letting 0 indicate simply to refresh the view.
@@ -377,6 +383,8 @@ void Model::updateObservers()
 	recursive++;
 	int change = m_changeBits; 
 	m_changeBits = 0; //2019
+	if(m_drawArrays) m_drawArrays->bits|=change; //2024
+	for(auto*ea:m_screenIndices) if(ea) ea->bits|=change;
 	for(auto*ea:m_observers) ea->modelChanged(change);
 	//m_changeBits = 0;
 	recursive--;
@@ -447,8 +455,7 @@ int Model::addVertex(double x, double y, double z)
 
 	if(auto fp=m_vertices.front()->m_frames.size())
 	{
-		vp->m_frames.assign(fp,nullptr);
-		while(fp-->0) vp->m_frames[fp] = FrameAnimVertex::get();
+		vp->m_frames.resize(fp);
 	}
 
 	Undo<MU_Add>(this,num,vp); return num;
@@ -466,18 +473,7 @@ int Model::addVertex(int copy, const double pos[3])
 	Vertex *vp = Vertex::get(m_addLayer,m_animationMode);	
 	m_vertices.push_back(vp);
 
-	if(auto fp=m_vertices.front()->m_frames.size())
-	{
-		vp->m_frames.assign(fp,nullptr);
-		while(fp-->0)
-		{
-			auto &f = vp->m_frames[fp];
-			auto &g = cp->m_frames[fp];
-			f = FrameAnimVertex::get();			
-			f->m_interp2020 = g->m_interp2020;
-			memcpy(f->m_coord,g->m_coord,3*sizeof(double));
-		}
-	}
+	vp->m_frames = cp->m_frames;
 	vp->m_influences = cp->m_influences;
 
 	if(!pos)
@@ -505,9 +501,9 @@ int Model::addVertex(int copy, const double pos[3])
 		{
 			for(int i=3;i-->0;) os[i]-=cp->m_coord[i];
 
-			for(auto&ea:vp->m_frames) if(ea->m_interp2020)
+			for(auto&ea:vp->m_frames) if(ea.m_interp2020)
 			{
-				for(int i=3;i-->0;) ea->m_coord[i]+=os[i];
+				for(int i=3;i-->0;) ea.m_coord[i] = (float)(ea.m_coord[i]+os[i]);
 			}
 		}
 	}
@@ -555,6 +551,93 @@ int Model::addTriangle(unsigned v1, unsigned v2, unsigned v3)
 	}
 	return -1;
 }
+//2024: Like reserve, but grows geometrically so that adding in many
+//small batches isn't quadratic.
+template<class T> static void model_reserve(std::vector<T> &v, size_t n)
+{
+	if(v.capacity()<n) v.reserve(std::max(n,v.capacity()*2));
+}
+int Model::addVertices(size_t n, const double *xyz)
+{
+	int num = m_vertices.size(); if(!n) return num;
+
+	m_changeBits |= AddGeometry;
+
+	model_reserve(m_vertices,num+n);
+
+	size_t fp = num?m_vertices.front()->m_frames.size():0;
+
+	Undo<MU_Add> undo;
+	for(size_t i=0;i<n;i++,xyz+=3)
+	{
+		Vertex *vp = Vertex::get(m_addLayer,m_animationMode);
+		
+		memcpy(vp->m_coord,xyz,3*sizeof(double));
+		memcpy(vp->m_kfCoord,xyz,3*sizeof(double));
+		m_vertices.push_back(vp);
+
+		if(fp) vp->m_frames.resize(fp);
+
+		if(i) //One MU_Add for all.
+		{
+			if(undo) undo->add(num+i,vp);
+		}
+		else undo = Undo<MU_Add>(this,num,vp);
+	}
+	return num;
+}
+int Model::addTriangles(size_t n, const unsigned *v, const float *st)
+{
+	int num = m_triangles.size(); if(!n) return num;
+
+	unsigned vsz = m_vertices.size();
+	for(size_t i=n*3;i-->0;) if(v[i]>=vsz) return -1;
+
+	invalidateAnim(); invalidateNormals();
+
+	m_changeBits |= AddGeometry;
+
+	//Count the new faces to size m_faces in one go.
+	std::vector<unsigned> fc(vsz);
+	for(size_t i=n*3;i-->0;) fc[v[i]]++;
+	for(unsigned i=vsz;i-->0;) if(fc[i])
+	{
+		auto &f = m_vertices[i]->m_faces; model_reserve(f,f.size()+fc[i]);
+	}
+
+	model_reserve(m_triangles,num+n);
+
+	Undo<MU_Add> undo;
+	for(size_t i=0;i<n;i++,v+=3)
+	{
+		Triangle *tp = Triangle::get(m_addLayer);
+		tp->_source(m_animationMode);
+
+		for(int j=3;j-->0;)
+		{
+			tp->m_vertexIndices[j] = v[j];
+
+			m_vertices[v[j]]->m_faces.push_back({tp,j});
+		}
+		if(st)
+		{
+			for(int j=0;j<3;j++,st+=2)
+			{
+				tp->m_s[j] = st[0]; tp->m_t[j] = st[1];
+			}
+		}
+		m_triangles.push_back(tp);
+
+		if(i) //One MU_Add for all.
+		{
+			if(undo) undo->add(num+i,tp);
+		}
+		else undo = Undo<MU_Add>(this,num,tp);
+	}
+	if(st) m_changeBits |= MoveTexture;
+
+	return num;
+}
 
 int Model::addBoneJoint(const char *name, int parent)
 {
@@ -725,7 +808,7 @@ bool Model::getTriangleVertices(unsigned t, unsigned &v1, unsigned &v2, unsigned
 
 void Model::deleteVertex(unsigned vertexNum)
 {
-	//LOG_PROFILE(); //???
+	LOG_PROFILE(); //2024
 
 	if(vertexNum>=m_vertices.size()) return;
 
@@ -735,10 +818,38 @@ void Model::deleteVertex(unsigned vertexNum)
 
 	removeVertex(vertexNum);
 }
+void Model::deleteVertices(const int_list &l, bool asc)
+{
+	if(l.empty()) return;
+
+	m_changeBits |= AddGeometry; //2020
+
+	auto *vl = m_vertices.data();
+	int cmp = (int)m_vertices.size();
+
+	Undo<MU_Delete> undo(this,PartVertices);
+
+	//2024: removeVertices renumbers the triangles once.
+	int_list desc; desc.reserve(l.size());
+	auto f = [&](int i)
+	{
+		if(i<cmp)
+		{
+			cmp = i; desc.push_back(i);
+
+			if(undo) undo->add(i,vl[i]);
+		}
+		else assert(0);
+	};
+	if(asc) for(auto rit=l.rbegin();rit<l.rend();rit++) f(*rit);
+	else for(int i:l) f(i);
+
+	removeVertices(desc);
+}
 
 void Model::deleteTriangle(unsigned t)
 {
-	//LOG_PROFILE(); //???
+	LOG_PROFILE(); //2024
 
 	if(t>=m_triangles.size()) return;
 
@@ -760,55 +871,32 @@ void Model::deleteTriangle(unsigned t)
 }
 void Model::deleteTriangles(const int_list &l, bool asc)
 {
-	auto *tl = m_triangles.data();
-	int sz = (int)m_triangles.size();
+	if(l.empty()) return; //2024
 
-	for(auto&i:l) if(i<sz)
-	{
-		//2022: Passing false is an optimization to
-		//avoid interleaving undo objects since that
-		//prevents MU_Delete from resuming/combining.
-		auto *tp = tl[i];	
-		if(tp->m_group>=0)
-		removeTriangleFromGroup(tp->m_group,i,false);
-	}
-	else assert(0);
+	auto *tl = m_triangles.data();
+	int cmp = (int)m_triangles.size();
 
 	//m_changeBits |= AddGeometry
 
 	Undo<MU_Delete> undo(this,PartFaces);
 
-	//TODO: It would be nice to do this in 
-	//contiguous blocks to limit memmove
-	//like patterns. It might help to sort
-	//the list, but it's const right now.
-
-	int cmp = sz; if(asc)
+	//2024: removeTriangles takes the triangles out of their groups
+	//and renumbers the groups once.
+	int_list desc; desc.reserve(l.size());
+	auto f = [&](int i)
 	{
-		auto rit = l.rbegin();
-		auto ritt = l.rend();
-		for(;rit<ritt;rit++)
+		if(i<cmp)
 		{
-			int i = *rit; if(i<cmp)
-			{
-				cmp = i;
+			cmp = i; desc.push_back(i);
 
-				if(undo) undo->add(i,tl[i]);
-
-				removeTriangle(i);
-			}
-			else assert(0);
+			if(undo) undo->add(i,tl[i]);
 		}
-	}
-	else for(int i:l) if(i<cmp)
-	{
-		cmp = i;
-
-		if(undo) undo->add(i,tl[i]);
+		else assert(0);
+	};
+	if(asc) for(auto rit=l.rbegin();rit<l.rend();rit++) f(*rit);
+	else for(int i:l) f(i);
 
-		removeTriangle(i);
-	}
-	else assert(0);
+	removeTriangles(desc);
 }
 
 void Model::deleteBoneJoint(unsigned joint)
@@ -876,31 +964,33 @@ void Model::deleteProjection(unsigned proj)
 
 unsigned Model::deleteOrphanedVertices(unsigned begin, unsigned i)
 {
-	unsigned ret = 0;
+	int_list l;
 	for(i=std::min(i,(unsigned)m_vertices.size());i-->begin;)
 	if(m_vertices[i]->m_faces.empty()) 
 	{
-		deleteVertex(i); ret++;
+		l.push_back(i);
 	}
-	return ret; //2020
+	deleteVertices(l,false); return (unsigned)l.size(); //2020
 }
 
 void Model::deleteFlattenedTriangles()
 {
-	//LOG_PROFILE(); //???
+	LOG_PROFILE(); //2024
 
 	// Delete any triangles that have two or more vertex indices that point
 	// at the same vertex (could happen as a result of welding vertices
 
+	int_list l; //2024
 	for(int t=m_triangles.size();t-->0;)
 	{
-		if(m_triangles[t]->_flattened()) deleteTriangle(t);	
+		if(m_triangles[t]->_flattened()) l.push_back(t);
 	}
+	deleteTriangles(l,false);
 }
 
 void Model::deleteSelected()
 {
-	//LOG_PROFILE(); //???
+	LOG_PROFILE(); //2024
 
 	auto lv = m_primaryLayers; //???
 
@@ -941,11 +1031,13 @@ void Model::deleteSelected()
 	}
 	deleteTriangles(tris,false);
 
+	int_list verts; //2024
 	for(auto v=m_vertices.size();v-->0;)	
 	if(m_vertices[v]->m_selected&&!m_vertices[v]->m_marked)
 	{
-		deleteVertex(v); //Or dissolveVertex?
+		verts.push_back(v); //Or dissolveVertex?
 	}	
+	deleteVertices(verts,false);
 	deleteOrphanedVertices(); //???
 
 	for(auto j=m_joints.size();j-->0;) if(m_joints[j]->m_selected)
@@ -1016,7 +1108,7 @@ bool Model::moveVertex(unsigned index, double x, double y, double z)
 
 	m_changeBits |= MoveGeometry;
 
-	invalidateNormals(); //OVERKILL
+	invalidateNormals(index);
 
 	return true;
 } 
@@ -1200,7 +1292,7 @@ void Model::interpolateSelected(Model::Interpolant2020E d, Model::Interpolate202
 				//if(0==~fp) _anim_valloc(fa);
 				if(0==~fp) fp = fa->_frame0(this);
 
-				auto vf = ea->m_frames[fp+cf];
+				auto vf = &ea->m_frames[fp+cf];
 				auto &cmp = vf->m_interp2020;
 				if(cmp!=e) 
 				{
@@ -1210,7 +1302,7 @@ void Model::interpolateSelected(Model::Interpolant2020E d, Model::Interpolate202
 				
 					//HACK: Maybe this value should already be stored.
 					if(cmp<=InterpolateCopy)					
-					memcpy(vf->m_coord,ea->m_kfCoord,sizeof(ea->m_kfCoord));
+					vf->setCoord(ea->m_kfCoord);
 
 					cmp = e;
 				}
@@ -1231,7 +1323,7 @@ void Model::translateSelected(const double vec[3])
 	//3) Move all (was current *bug* for rotating w/ animation)
 	//(3 can be pretty interesting, but might have applications)
 
-	//LOG_PROFILE(); //???
+	LOG_PROFILE(); //2024
 
 	if(!vec[0]&&!vec[1]&&!vec[2]) return; //2020
 
@@ -1399,7 +1491,8 @@ void Model::translateSelected(const double vec[3])
 			{
 				m_changeBits |= MoveGeometry;
 
-				invalidateNormals(); //OVERKILL
+				for(auto i=m_vertices.size();i-->0;)
+				if(m_vertices[i]->m_selected) invalidateNormals(i);
 			}
 		}
 
@@ -1507,7 +1600,7 @@ void Model::rotateSelected(const Matrix &m, const double point[3])
 	//3) Move all (was current *bug* for rotating w/ animation)
 	//(3 can be pretty interesting, but might have applications)
 
-	//LOG_PROFILE(); //???
+	LOG_PROFILE(); //2024
 
 	int multi = 0 ; //2021
 	bool skel = inSkeletalMode();
@@ -1675,7 +1768,8 @@ void Model::rotateSelected(const Matrix &m, const double point[3])
 			{
 				m_changeBits |= MoveGeometry;
 
-				invalidateNormals(); //OVERKILL
+				for(auto i=m_vertices.size();i-->0;)
+				if(m_vertices[i]->m_selected) invalidateNormals(i);
 			}
 		}
 		
@@ -1812,7 +1906,7 @@ void Model::rotateSelected(const Matrix &m, const double point[3])
 //void Model::applyMatrix(const Matrix &m, OperationScopeE scope, bool undoable)
 void Model::applyMatrix(Matrix m, OperationScopeE scope, bool undoable)
 {
-	//LOG_PROFILE(); //???
+	LOG_PROFILE(); //2024
 	
 	//NOTE: I think "undoable" is in case the matrix
 	//isn't invertible. 
@@ -1841,9 +1935,10 @@ void Model::applyMatrix(Matrix m, OperationScopeE scope, bool undoable)
 
 		m.apply3x(m_vertices[v]->m_coord);
 
-		for(auto*ea:m_vertices[v]->m_frames) 
+		for(auto&ea:m_vertices[v]->m_frames) 
 		{
-			m.apply3x(ea->m_coord);
+			double c[3]; ea.getCoord(c);
+			m.apply3x(c); ea.setCoord(c);
 		}
 	}
 	if(verts) 
@@ -2019,7 +2114,7 @@ struct SplitEdgesT
 };
 bool Model::subdivideSelectedTriangles()
 {
-	//LOG_PROFILE(); //???
+	LOG_PROFILE(); //2024
 
 	sorted_list<SplitEdgesT> seList;
 
@@ -2271,7 +2366,7 @@ const char *Model::getRedoOpName()const
 
 void Model::undo(int how)
 {
-	//LOG_PROFILE(); //???
+	LOG_PROFILE(); //2024
 
 	assert(m_undoEnabled); //2022
 
@@ -2385,7 +2480,7 @@ void Model::hidePoint(unsigned i, unsigned layer) //UNSAFE???
 
 bool Model::hideSelected(bool how, unsigned layer)
 {
-	//LOG_PROFILE(); //???
+	LOG_PROFILE(); //2024
 
 	//If assigning to a layer the elements won't
 	//already be on that layer, so it's no good
@@ -2505,7 +2600,7 @@ bool Model::hideSelected(bool how, unsigned layer)
 
 bool Model::unhideAll()
 {
-	//LOG_PROFILE(); //???
+	LOG_PROFILE(); //2024
 
 	auto lv = m_primaryLayers;
 
@@ -2545,7 +2640,7 @@ bool Model::unhideAll()
 
 void Model::invertHidden()
 {
-	//LOG_PROFILE(); //???
+	LOG_PROFILE(); //2024
 
 	auto lv = m_primaryLayers;
 
@@ -2879,7 +2974,7 @@ void Model::invertNormal(unsigned triangleNum)
 }
 void Model::invertNormals(const int_list &l)
 {
-	//LOG_PROFILE(); //???
+	LOG_PROFILE(); //2024
 
 	if(l.empty()) return;
 
@@ -3047,7 +3142,7 @@ void Model::appendUndo(::Undo *undo)
 		if(!st.empty()&&!st.back()->empty()
 		&&typeid(*st.back()->back())!=typeid(*undo)) 
 		{
-			st.back()->push_back(undo);
+			m_undoMgr->appendUndo(undo);
 			return;
 		}
 	}
@@ -3538,7 +3633,7 @@ void Model::calculateNormals()
 	//CAUTION: I've changed this to fill out the animation "source" normals
 	//when selected.
 
-	//LOG_PROFILE(); //???
+	LOG_PROFILE(); //2024
 
 	//INSANITY
 	//Note: I've used static to avoid reallocations but it's not threadsafe
@@ -3546,10 +3641,14 @@ void Model::calculateNormals()
 	//acl_normmap.resize(std::max(acl_normmap.size(),m_vertices.size()));
 	//for(size_t i=m_vertices.size();i-->0;) acl_normmap[i].clear();
 
-	for(Triangle*tri:m_triangles) // accumulate normals
-	{
-		tri->m_marked = false;
+	//2024: invalidateNormals(unsigned) lists moved vertices so that only
+	//the triangles around them are recalculated. These are the triangles
+	//touching a moved vertex (flat normal/angles) plus the triangles that
+	//share a vertex with one of those (corner normals.)
+	bool partial = !m_animationMode&&!m_dirtyNormals.empty();
 
+	auto flat = [&](Triangle *tri) // accumulate normals
+	{
 		//FIX ME
 		//I think the area calculation should be factored into the 
 		//weights but historically that wasn't the case. For right
@@ -3666,76 +3765,22 @@ void Model::calculateNormals()
 			tri->m_angleSource[i] = acos(dp[i]);
 		}
 		else tri->m_angleSource[i] = 1; //TESTING
-	}
+	};
 
 	// Apply accumulated normals to triangles
 
-	for(unsigned g=0;g<m_groups.size();g++)
-	{
-		Group *grp = m_groups[g];
-
-		double maxAngle = 
-		std::max(0.5*PIOVER180,grp->m_angle*PIOVER180);
-
-		for(int i:grp->m_triangleIndices)
-		{
-			Triangle *tri = m_triangles[i];
-			tri->m_marked = true;
-			for(int vert=3;vert-->0;)
-			{
-				unsigned v = tri->m_vertexIndices[vert];
-								
-				auto &acl = m_vertices[v]->m_faces;
-
-				double A = 0;
-				double B = 0;
-				double C = 0; for(auto&ea:acl)
-				{
-					auto tri2 = ea.first;
-					auto ea_norm = tri2->m_flatSource;
-					double dotprod = dot3(tri->m_flatSource,ea_norm);
-
-					// Don't allow it to go over 1
-					double angle = 0;
-					if(dotprod<0.99999)
-					{
-						angle = fabs(acos(dotprod));
-					}
-
-					double w = tri2->m_angleSource[ea.second];
-
-					if(angle<=maxAngle)
-					{
-						A += ea_norm[0]*w;
-						B += ea_norm[1]*w;
-						C += ea_norm[2]*w;
-					}
-				}
-
-				double len = magnitude(A,B,C);
-
-				if(len>=0.0001f)
-				{
-					tri->m_normalSource[vert][0] = A/len;
-					tri->m_normalSource[vert][1] = B/len;
-					tri->m_normalSource[vert][2] = C/len;
-				}
-				else for(int i=3;i-->0;)
-				{
-					tri->m_normalSource[vert][i] = tri->m_flatSource[i];
-				}				
-			}
-		}
-	}
-
-	for(Triangle*tri:m_triangles) if(!tri->m_marked)
+	auto smooth = [&](Triangle *tri)
 	{
-		double maxAngle = 45*PIOVER180; //???
+		//NOTE: Historically all of the groups were done first and then
+		//the ungrouped triangles. A triangle belongs to just one group.
+		int g = tri->m_group;
+		double maxAngle = g<0?45*PIOVER180: //???
+		std::max(0.5*PIOVER180,m_groups[g]->m_angle*PIOVER180);
 
 		for(int vert=3;vert-->0;)
 		{
 			unsigned v = tri->m_vertexIndices[vert];
-			
+
 			//std::vector<NormAngleAccum> &acl = acl_normmap[v];
 			auto &acl = m_vertices[v]->m_faces;
 
@@ -3777,29 +3822,72 @@ void Model::calculateNormals()
 				tri->m_normalSource[vert][i] = tri->m_flatSource[i];
 			}			
 		}
-	}
-	else tri->m_marked = false; //???
+	};
 
-	for(Group*grp:m_groups)
+	auto blend = [&](Triangle *tri)
 	{
+		int g = tri->m_group; if(g<0) return;
+
+		Group *grp = m_groups[g];
+
 		double percent = grp->m_smooth*0.0039215686274509; //1/255
-		for(int i:grp->m_triangleIndices)
+
+		for(int v=3;v-->0;) if(grp->m_smooth>0)
+		{
+			for(int i=3;i-->0;)
+			tri->m_normalSource[v][i] = tri->m_flatSource[i]
+			+(tri->m_normalSource[v][i]-tri->m_flatSource[i])*percent;
+			normalize3(tri->m_normalSource[v]);
+		}
+		else for(int i=3;i-->0;)
 		{
-			Triangle *tri = m_triangles[i];
+			tri->m_normalSource[v][i] = tri->m_flatSource[i];
+		}
+	};
 
-			for(int v=3;v-->0;) if(grp->m_smooth>0)
-			{
-				for(int i=3;i-->0;)
-				tri->m_normalSource[v][i] = tri->m_flatSource[i]
-				+(tri->m_normalSource[v][i]-tri->m_flatSource[i])*percent;
-				normalize3(tri->m_normalSource[v]);
-			}
-			else for(int i=3;i-->0;)
-			{
-				tri->m_normalSource[v][i] = tri->m_flatSource[i];
-			}
+	if(!partial)
+	{
+		//Each pass only writes to its own triangles but reads the
+		//previous pass's results for the neighbors, so they can't be
+		//fused.
+		auto &tl = m_triangles;
+		parallel_for(tl.size(),1024,[&](size_t i, size_t n)
+		{
+			for(;i<n;i++){ tl[i]->m_marked = false; flat(tl[i]); }
+		});
+		parallel_for(tl.size(),1024,[&](size_t i, size_t n)
+		{
+			for(;i<n;i++) smooth(tl[i]);
+		});
+		parallel_for(tl.size(),1024,[&](size_t i, size_t n)
+		{
+			for(;i<n;i++) blend(tl[i]);
+		});
+	}
+	else
+	{
+		std::vector<Triangle*> t1,t2;
+		for(unsigned v:m_dirtyNormals) if(v<m_vertices.size())
+		{
+			for(auto&ea:m_vertices[v]->m_faces) t1.push_back(ea.first);
+		}
+		std::sort(t1.begin(),t1.end());
+		t1.erase(std::unique(t1.begin(),t1.end()),t1.end());
+
+		for(auto*tri:t1)
+		{
+			flat(tri);
+
+			for(int i=3;i-->0;)
+			for(auto&ea:m_vertices[tri->m_vertexIndices[i]]->m_faces)
+			t2.push_back(ea.first);
 		}
+		std::sort(t2.begin(),t2.end());
+		t2.erase(std::unique(t2.begin(),t2.end()),t2.end());
+
+		for(auto*tri:t2){ smooth(tri); blend(tri); }
 	}
+	if(!m_animationMode) m_dirtyNormals.clear();
 
 	(m_animationMode?m_validAnimNormals:m_validNormals) = true;
 
@@ -3818,9 +3906,33 @@ void Model::invalidateNormals()
 	
 	m_validNormals = false;
 
+	m_dirtyNormals.clear(); //2024
+
 	//NOTE: calculateNormals calls invalidateBspTree?
 	invalidateBspTree();
 }
+void Model::invalidateNormals(unsigned v)
+{
+	//2024: m_dirtyNormals is empty unless the base normals are only
+	//invalid around these vertices. When many vertices move it's
+	//better to recalculate everything.
+	if(m_validNormals||!m_dirtyNormals.empty())
+	{
+		if(m_dirtyNormals.size()<m_vertices.size()/8)
+		{
+			m_dirtyNormals.push_back(v);
+		}
+		else m_dirtyNormals.clear();
+	}
+
+	m_changeBits |= MoveNormals;
+
+	m_validAnimNormals = false;
+	
+	m_validNormals = false;
+
+	invalidateBspTree();
+}
 void Model::invalidateAnimNormals()
 {
 	m_changeBits |= MoveNormals;
@@ -3843,16 +3955,29 @@ bool Model::validateNormals()const
 
 void Model::calculateBspTree()
 {
+	LOG_PROFILE(); //2024
+
 	//log_debug("calculating BSP tree\n");
 	m_bspTree.clear();
 
+	bool blend = false; //2024
 	for(auto*gp:m_groups)
 	{
 		int index = gp->m_materialIndex;
 		if(index>=0&&m_materials[index]->needsAlpha())
-		m_bspTree.addTriangles(this,gp->m_triangleIndices);
+		{
+			m_bspTree.addTriangles(this,gp->m_triangleIndices);
+
+			if(!m_materials[index]->m_accumulate) blend = true;
+		}
 	}
-	m_bspTree.partition(); //2022
+	//2024: Additive (m_accumulate) blending doesn't depend on the
+	//order. Animation invalidates the tree every frame, so it's not
+	//worth cutting up the triangles to get them in exact order.
+	auto sort = BspTree::SORT_BSP;
+	if(!blend) sort = BspTree::SORT_NONE;
+	else if(m_animationMode) sort = BspTree::SORT_CENTERS;
+	m_bspTree.partition(sort); //2022
 
 	m_validBspTree = true;
 }
@@ -3893,7 +4018,7 @@ void model_show_alloc_stats()
 	log_debug("\n");
 	log_debug("primitive allocation stats (recycler/total)\n");
 
-	log_debug("Model: none/%d\n",model_allocated);
+	log_debug("Model: none/%d\n",(int)model_allocated);
 	Model::Vertex::stats();
 	Model::Triangle::stats();
 	Model::Group::stats();
@@ -3903,14 +4028,13 @@ void model_show_alloc_stats()
 	Model::Point::stats();
 	Model::TextureProjection::stats();
 	Model::Animation::stats();
-	Model::FrameAnimVertex::stats();
 //	Model::FrameAnimPoint::stats();
 	Model::BspTree::stats();
 //	Model::BspTree::stats2();
-	log_debug("Textures: none/%d\n",Texture::s_allocated);
+	log_debug("Textures: none/%d\n",(int)Texture::s_allocated);
 	log_debug("GlTextures: none/%d\n",Model::s_glTextures);
 #ifdef MM3D_EDIT
-	log_debug("ModelUndo: none/%d\n",ModelUndo::s_allocated);
+	log_debug("ModelUndo: none/%d\n",(int)ModelUndo::s_allocated);
 #endif // MM3D_EDIT
 	log_debug("\n");
 }
@@ -3933,7 +4057,6 @@ int model_free_primitives()
 	c += Model::BspTree::flush(); //nodes
 	c += Model::BspTree::flush2(); //triangles
 	//c += Model::FrameAnim::flush();
-	c += Model::FrameAnimVertex::flush();
 //	c += Model::FrameAnimPoint::flush();
 
 	return c;
@@ -478,10 +478,31 @@ public:
 	class FrameAnimVertex;
 	class Keyframe;
 
-	typedef std::vector<FrameAnimVertex*> FrameAnimVertexList;
+	typedef std::vector<FrameAnimVertex> FrameAnimVertexList;
 
 	// TODO: Probably should use a map for the KeyframeList
-	typedef sorted_ptr_list<Keyframe*> KeyframeList;		
+	//typedef sorted_ptr_list<Keyframe*> KeyframeList;		
+	class KeyframeList : public sorted_ptr_list<Keyframe*>
+	{
+	public: //2024: interpKeyframe
+
+		//Each channel's (KeyTranslate/KeyRotate/KeyScale) keys
+		//as indices into this list, rebuilt when "changes" has
+		//changed. _index is const so it's locked to be safe for
+		//concurrent lookups, but only when it must be rebuilt.
+		mutable std::vector<unsigned> m_index[3];
+		mutable std::atomic<unsigned> m_indexed{~0u};
+
+		void _index()const;
+
+		KeyframeList(){}
+		KeyframeList(const KeyframeList &cp)
+		:sorted_ptr_list(cp){}
+		KeyframeList &operator=(const KeyframeList &cp)
+		{
+			sorted_ptr_list::operator=(cp); m_indexed = ~0u; return *this;
+		}
+	};
 	//typedef std::vector<KeyframeList> ObjectKeyframeList;
 	typedef std::unordered_map<Position,KeyframeList,Position::hash> ObjectKeyframeList;
 	
@@ -553,29 +574,45 @@ public:
 		struct Node;
 		struct Poly;
 
-		BspTree():m_root(){};
+		BspTree():m_root(),m_sort(){};
 		~BspTree(){ clear(); };
 
 		void render(double *point, Draw&);
 		void addTriangles(Model*,int_list&);
-		void partition(); //2022
 		void clear();
 		bool empty(){ return !m_root; }
 
+		//2024: SORT_CENTERS skips building the tree and instead sorts
+		//the triangles back to front by their centers when rendering.
+		//SORT_NONE is for blending that doesn't depend on the order.
+		enum SortE{ SORT_BSP=0, SORT_CENTERS, SORT_NONE };
+		void partition(SortE=SORT_BSP); //2022
+
 		static int flush();
 		static int flush2();
 		static void stats();
 
+		//2024: Figures for the last partition (logged by stats.)
+		struct Stats
+		{
+			int triangles,polys,nodes,depth; double ms;
+		};
+		static const Stats &getStats(){ return s_stats; }
+
 	protected:
 
 		Node *m_root;
 
-		static std::vector<Node*> s_recycle;
-		static std::vector<Poly*> s_recycle2;
+		SortE m_sort;
+
+		static thread_local Stats s_stats;
+
+		static thread_local std::vector<Node*> s_recycle;
+		static thread_local std::vector<Poly*> s_recycle2;
 
-		static int s_allocated,s_allocated2;
+		static std::atomic<int> s_allocated,s_allocated2;
 	};
-	
+
 	struct InfluenceT
 	{
 		int m_boneId;
@@ -624,6 +661,7 @@ public:
 	Animation *_anim(unsigned,unsigned,Position,bool=true)const;
 	bool _anim_check(bool model_status_report=false);
 	void _anim_valloc(const Animation *lazy_mutable);
+	void _resample_vertices(); //calculateAnim
 	bool _skel_xform_abs(int inv,infl_list&,Vector&v);
 	bool _skel_xform_rot(int inv,infl_list&,Matrix&m);
 	bool _skel_xform_mat(int inv,infl_list&,Matrix&m);
@@ -792,6 +830,16 @@ public:
 
 	void _drawMaterial(BspTree::Draw&, int g);
 
+	//2024: Retained vertex arrays for draw/_drawPolygons.
+	struct DrawArrays;
+	DrawArrays &_drawArrays(int parts);
+
+	//2024: Screen space grid for picking by the *InVolumeMatrix
+	//functions and ModelViewport::getParentCoords. It's rebuilt
+	//when the geometry or matrix changes. A few are kept (views.)
+	struct ScreenIndex;
+	const ScreenIndex &_screenIndex(const Matrix &viewMat, int parts);
+
 	//NOTE: m is ModelViewport::ViewOptionsE
 	void setCanvasDrawMode(int m){ m_canvasDrawMode = m; };
 	int getCanvasDrawMode()const { return m_canvasDrawMode; };
@@ -976,7 +1024,7 @@ public:
 
 	unsigned getAnimFrameCount(unsigned anim)const;
 		
-	typedef std::vector<FrameAnimVertex*> FrameAnimData;
+	typedef std::vector<FrameAnimVertex> FrameAnimData;
 	bool setAnimFrameCount(unsigned anim, unsigned count);
 	bool setAnimFrameCount(unsigned anim, unsigned count, unsigned where, FrameAnimData*);
 
@@ -1116,6 +1164,9 @@ public:
 	//NEW: Invalidates normals both for animations and base model.
 	//TODO: Replace these with spot fix repair system.
 	void invalidateNormals(),invalidateAnimNormals();
+	//2024: Like invalidateNormals but the base model's normals are only
+	//recalculated around the vertex (unless many vertices are moved.)
+	void invalidateNormals(unsigned vertex);
 
 	//NEW: Calls calculateNormals if current normals requier repairs.
 	bool validateNormals()const;
@@ -1196,8 +1247,17 @@ public:
 	int addVertex(int copy, const double pos[3]=0);
 	int addTriangle(unsigned vert1, unsigned vert2, unsigned vert3);
 
+	//2024: Bulk versions of addVertex/addTriangle for filters. These
+	//append n vertices/triangles at once. xyz and v are n*3 elements
+	//and st (optional) is n*6 (s,t pairs for each triangle vertex.)
+	//They return the index of the first new vertex/triangle, or -1 
+	//if a triangle's vertex index is out of range.
+	int addVertices(size_t n, const double *xyz);
+	int addTriangles(size_t n, const unsigned *v, const float *st=nullptr);
+
 	//2020: This API leaves dangling references to vertices! (UNSAFE)
 	void deleteVertex(unsigned vertex);
+	void deleteVertices(const int_list &sorted, bool ascending_order); //2024
 	void deleteTriangle(unsigned triangle);
 	void deleteTriangles(const int_list &sorted, bool ascending_order);
 
@@ -1360,6 +1420,11 @@ public:
 	bool addTriangleToGroup(unsigned groupNum, unsigned triangleNum,bool undo=true);
 	bool removeTriangleFromGroup(unsigned groupNum, unsigned triangleNum,bool undo=true);
 	bool ungroupTriangle(unsigned triangleNum);
+	//2024: Regroups a list of triangles (-1 ungroups) with one pass
+	//over each affected group. The second form gives each triangle
+	//its own group unless groupNums has only one.
+	bool setTrianglesGroup(const int_list &triangles, int groupNum);
+	bool setTrianglesGroup(const int_list &triangles, const int_list &groupNums);
 	void setSelectedAsGroup(unsigned groupNum);
 	void addSelectedToGroup(unsigned groupNum);
 	int getTriangleGroup(unsigned triangleNumber)const;
@@ -1460,6 +1525,8 @@ public:
 	bool setPointInfluenceWeight(unsigned point, unsigned joint, double weight);
 
 	bool autoSetPositionInfluences(const Position &pos, double sensitivity, bool selected);
+	//2024: This looks up the skeleton once and does the lookups in parallel.
+	bool autoSetPositionInfluences(const pos_list &l, double sensitivity, bool selected);
 	bool autoSetVertexInfluences(unsigned vertex, double sensitivity, bool selected);
 	bool autoSetPointInfluences(unsigned point, double sensitivity, bool selected);
 	bool autoSetCoordInfluences(double *coord, double sensitivity, bool selected, int_list &infList);
@@ -1608,6 +1675,14 @@ public:
 	void removeTriangle(unsigned index);
 	void remapTrianglesIndices(const int_list&);
 
+	//2024: These are removeVertex/removeTriangle called for each index
+	//in desc, which must be descending, but the indices are renumbered
+	//in one pass. The insert versions undo them (in ascending order.)
+	void removeVertices(const int_list &desc);
+	void insertVertices(const int_list &desc, Vertex *const*);
+	void removeTriangles(const int_list &desc);
+	void insertTriangles(const int_list &desc, Triangle *const*);
+
 	void insertGroup(unsigned index,Group *group);
 	void removeGroup(unsigned index);
 
@@ -1639,7 +1714,7 @@ public:
 
 	//INTERNAL: setFrameCount subroutines
 	void insertFrameAnimData(unsigned frame0, unsigned frames, FrameAnimData *data, const Animation *draw);
-	void removeFrameAnimData(unsigned frame0, unsigned frames, FrameAnimData *data, bool release=false);
+	void removeFrameAnimData(unsigned frame0, unsigned frames, FrameAnimData *data);
 
 	// ------------------------------------------------------------------
 	// Selection functions
@@ -1951,7 +2026,7 @@ protected:
 	std::string	m_filename;
 	std::string	m_exportFile;
 	std::string	m_filterSpecificError;
-	static std::string s_lastFilterError;
+	static thread_local std::string s_lastFilterError; //2024
 
 	std::list<std::string> m_loadErrors; //queue
 
@@ -1976,6 +2051,11 @@ protected:
 
 	BspTree m_bspTree;
 
+	DrawArrays *m_drawArrays; //2024
+
+	enum{ SCREEN_INDICES=4 };
+	ScreenIndex *m_screenIndices[SCREEN_INDICES]; //2024
+
 	std::vector<FormatData*> m_formatData;
 		
 	//2019: Changing to int to break depenency on the
@@ -1993,6 +2073,7 @@ protected:
 
 	bool m_validNormals;		
 	bool m_validAnimNormals; //2020
+	std::vector<unsigned> m_dirtyNormals; //2024: invalidateNormals(unsigned)
 
 	bool m_skeletalMode;
 	bool m_skeletalMode2;
@@ -2127,6 +2208,37 @@ struct Model::_OrderedSelection //EXPERIMENTAL
 	bool operator==(Marker &m){ return m._op==_select_op; }
 };
 
+// Describes the position for a vertex in a frame animation.
+//2024: Vertex::m_frames holds these by value. They had been pooled
+//objects with double coordinates. float is what MM3D files store.
+class Model::FrameAnimVertex
+{
+public:
+
+	float m_coord[3];
+//	double m_normal[3]; //https://github.com/zturtleman/mm3d/issues/109
+
+	Interpolate2020E m_interp2020;
+
+	FrameAnimVertex():m_coord(),m_interp2020(InterpolateNone){}
+
+	void getCoord(double xyz[3])const
+	{
+		for(int i=3;i-->0;) xyz[i] = m_coord[i];
+	}
+	void setCoord(const double xyz[3])
+	{
+		for(int i=3;i-->0;) m_coord[i] = (float)xyz[i];
+	}
+
+	bool propEqual(const FrameAnimVertex &rhs, int propBits=PropAllSuitable, double tolerance=0.00001)const;
+	bool operator==(const FrameAnimVertex &rhs)const{ return propEqual(rhs); }
+
+	//This is standard lerp as implemented by interpKeyframe. z can equal x or y.
+	static void lerp(const double x[3], const double y[3], double t, double z[3]);
+	static void lerp(const float x[3], const float y[3], double t, double z[3]);
+};
+
 // A vertex defines a polygon corner. The position is in m_coord.
 // All triangles in all groups (meshes)references triangles from this
 // one list.
@@ -2192,8 +2304,10 @@ protected:
 	Vertex(),~Vertex();
 	void init();
 
-	static std::vector<Vertex*> s_recycle;
-	static int s_allocated;
+	//2024: The recycling lists are per thread so models can be
+	//worked on by separate threads. See cmdline.cc (--jobs.)
+	static thread_local std::vector<Vertex*> s_recycle;
+	static std::atomic<int> s_allocated;
 };
 
 // A triangle represents faces in the model. All faces are triangles.
@@ -2263,8 +2377,8 @@ protected:
 	Triangle(),~Triangle();
 	void init();
 
-	static std::vector<Triangle*> s_recycle;
-	static int s_allocated;
+	static thread_local std::vector<Triangle*> s_recycle;
+	static std::atomic<int> s_allocated;
 };
 
 // Group of triangles. All triangles in a group share a material (if one
@@ -2289,6 +2403,8 @@ public:
 	//Draw code is order-independent. 
 	//std::set<int> m_triangleIndices;  // List of triangles in this group
 	//std::unordered_set<int> m_triangleIndices;  // List of triangles in this group
+	//2024: This is kept sorted. Triangle::m_group is the membership
+	//test. Use setTrianglesGroup to move more than a few triangles.
 	int_list m_triangleIndices;
 
 	// Percentage of blending between flat normals and smooth normals
@@ -2315,8 +2431,8 @@ protected:
 	Group(),~Group();
 	void init();
 
-	static std::vector<Group*> s_recycle;
-	static int s_allocated;
+	static thread_local std::vector<Group*> s_recycle;
+	static std::atomic<int> s_allocated;
 };
 
 // The Material defines how lighting is reflected off of triangles and
@@ -2377,8 +2493,8 @@ protected:
 	Material(),~Material();
 	void init();
 
-	static std::vector<Material*> s_recycle;
-	static int s_allocated;
+	static thread_local std::vector<Material*> s_recycle;
+	static std::atomic<int> s_allocated;
 };
 
 struct Model::Object2020 : public Visible2022 //RENAME ME
@@ -2514,8 +2630,8 @@ protected:
 	Joint(),~Joint();
 	void init();
 
-	static std::vector<Joint*> s_recycle;
-	static int s_allocated;
+	static thread_local std::vector<Joint*> s_recycle;
+	static std::atomic<int> s_allocated;
 };
 
 class Model::Point : public Object2020
@@ -2574,8 +2690,8 @@ protected:
 	Point(),~Point();
 	void init();
 
-	static std::vector<Point*> s_recycle;
-	static int s_allocated;
+	static thread_local std::vector<Point*> s_recycle;
+	static std::atomic<int> s_allocated;
 };
 
 // A TextureProjection is used automatically map texture coordinates to a group
@@ -2613,7 +2729,7 @@ protected:
 	TextureProjection(),~TextureProjection();
 	void init();
 
-	static int s_allocated;
+	static std::atomic<int> s_allocated;
 };
 
 
@@ -2706,40 +2822,8 @@ protected:
 	Animation(),~Animation();
 	void init();
 
-	static std::vector<Animation*> s_recycle;
-	static int s_allocated;
-};
-
-
-// Describes the position and normal for a vertex in a frame animation.
-class Model::FrameAnimVertex
-{
-public:
-	static int flush();
-	static int allocated(){ return s_allocated; }
-	static int recycled(){ return s_recycle.size(); }
-	static void stats();
-	static FrameAnimVertex *get();
-	void release();
-	void sprint(std::string &dest);
-
-	double m_coord[3];
-//	double m_normal[3]; //https://github.com/zturtleman/mm3d/issues/109
-
-	Interpolate2020E m_interp2020;
-
-	bool propEqual(const FrameAnimVertex &rhs, int propBits=PropAllSuitable, double tolerance=0.00001)const;
-	bool operator==(const FrameAnimVertex &rhs)const{ return propEqual(rhs); }
-
-	//This is standard lerp as implemented by interpKeyframe. z can equal x or y.
-	static void lerp(const double x[3], const double y[3], double t, double z[3]);
-
-protected:
-	FrameAnimVertex(),~FrameAnimVertex();
-	void init();
-
-	static std::vector<FrameAnimVertex*> s_recycle;
-	static int s_allocated;
+	static thread_local std::vector<Animation*> s_recycle;
+	static std::atomic<int> s_allocated;
 };
 
 // A keyframe for a single joint in a single frame. Keyframes may be rotation or 
@@ -2804,8 +2888,8 @@ protected:
 
 	void init(); //UNUSED (NOP)
 
-	static std::vector<Keyframe*> s_recycle;
-	static int s_allocated;
+	static thread_local std::vector<Keyframe*> s_recycle;
+	static std::atomic<int> s_allocated;
 };
 
 // FormatData is used to store data that is used by specific file formats
@@ -2947,4 +3031,117 @@ struct Model::BspTree::Draw
 	int bsp_group; bool bsp_selected;
 };
 
+//2024: This is what Model::draw draws from instead of glBegin/glEnd.
+//Attributes are per triangle corner (3 per triangle) since normals
+//and texture coordinates are. Parts are only rebuilt when ChangeBits
+//say they changed, so redrawing a still model just costs the draws.
+struct Model::DrawArrays
+{
+	//32B alignment is so SIMD loops can use aligned loads/stores.
+	template<class T> struct aligned_allocator
+	{
+		typedef T value_type;
+
+		aligned_allocator(){}
+		template<class U> aligned_allocator(const aligned_allocator<U>&){}
+
+		T *allocate(size_t n)
+		{
+			void *p = nullptr;
+			#ifdef _MSC_VER
+			p = _aligned_malloc(n*sizeof(T),32);
+			#else
+			if(posix_memalign(&p,32,n*sizeof(T))) p = nullptr;
+			#endif
+			if(!p) throw std::bad_alloc(); return (T*)p;
+		}
+		void deallocate(T *p, size_t)
+		{
+			#ifdef _MSC_VER
+			_aligned_free(p);
+			#else
+			free(p);
+			#endif
+		}
+		template<class U> bool operator==(const aligned_allocator<U>&)const{ return true; }
+		template<class U> bool operator!=(const aligned_allocator<U>&)const{ return false; }
+	};
+	template<class T> using array = std::vector<T,aligned_allocator<T>>;
+
+	enum PartsE
+	{
+		Coords      = 0x01, // coords
+		Normals     = 0x02, // normals (DO_SMOOTHING)
+		FlatNormals = 0x04, // flatNormals
+		TexCoords   = 0x08, // st
+		Indices     = 0x10, // indices, ranges
+	};
+	int valid; 
+	
+	//Model::updateObservers adds to this since it clears m_changeBits.
+	unsigned bits;
+
+	//These catch changes that ChangeBits don't cover.
+	size_t triangles,groups; unsigned layers; int animationMode;
+
+	array<float> coords;      // 9 per triangle (m_absSource)
+	array<float> normals;     // 9 per triangle (m_normalSource)
+	array<float> flatNormals; // 9 per triangle (m_flatSource)
+	array<float> st;          // 6 per triangle
+	array<float> colors;      // 12 per triangle (filled by draw)
+
+	//Visible triangles' corners by group, ungrouped last. Each group
+	//has 4 ranges values: unselected begin, selected begin, selected
+	//end, and if the last triangle (in group order) is selected.
+	array<unsigned> indices; std::vector<unsigned> ranges;
+
+	//_drawPolygons draws in reverse. unselected, then selected.
+	array<unsigned> polygons; unsigned polygons_selected;
+
+	DrawArrays():valid(),bits(),triangles(),groups(),layers(),animationMode(){}
+};
+
+//2024: Vertices and triangles projected by a view matrix and bucketed
+//in a uniform grid so picking doesn't have to apply4 every vertex. It
+//can only say what's near. The callers repeat their exact tests on the
+//results, so they select/snap the same things as visiting everything.
+struct Model::ScreenIndex
+{
+	enum PartsE
+	{
+		Vertices  = 0x01, // xy, vertexCells, vertexList
+		Triangles = 0x02, // triangleCells, triangleList, big (and Vertices)
+	};
+	int valid;
+
+	//If set the grid isn't built because the vertices are moving. The
+	//find functions return every index then.
+	bool scan;
+
+	Matrix matrix; 
+	
+	//Model::updateObservers adds to this since it clears m_changeBits.
+	unsigned bits; 
+	
+	size_t vertices,triangles; int animationMode; unsigned stamp;
+
+	//2 per vertex, after dividing by w. NaN if w<=0.
+	std::vector<float> xy;
+
+	//The grid is cols x rows with offsets into the lists (+1.) Triangles
+	//are filed under the cell of their lower corner and may reach over
+	//spread more cells. If they are wider they're in big instead.
+	double x0,y0,inv,eps; int cols,rows,spread;
+	std::vector<unsigned> vertexCells,vertexList;
+	std::vector<unsigned> triangleCells,triangleList,big;
+
+	//These fill the vector with indices in ascending order of vertices
+	//or triangles that may be in the rectangle, which must have x1<=x2
+	//and y1<=y2.
+	void findVertices(double x1, double y1, double x2, double y2, std::vector<unsigned>&)const;
+	void findTriangles(double x1, double y1, double x2, double y2, std::vector<unsigned>&)const;
+
+	ScreenIndex():valid(),scan(),bits(),vertices(),triangles(),animationMode(),stamp(),cols(),rows(),spread(){}
+};
+
 #endif //__MODEL_H
@@ -31,6 +31,24 @@
 
 #include "log.h"
 #include "glmath.h"
+#include "parallel.h"
+
+#include <mutex> //2024
+
+#if defined(__GNUC__)&&(defined(__x86_64__)||defined(__i386__))
+#include <immintrin.h>
+#define MODEL_SKIN_AVX __attribute__((target("avx")))
+static bool model_skin_has_avx(){ return __builtin_cpu_supports("avx"); }
+#elif defined(_MSC_VER)&&defined(_M_X64)
+#include <immintrin.h>
+#include <intrin.h>
+#define MODEL_SKIN_AVX
+static bool model_skin_has_avx()
+{
+	int r[4]; __cpuid(r,1); //OSXSAVE and AVX
+	return (r[2]&0x18000000)==0x18000000&&(_xgetbv(0)&6)==6;
+}
+#endif
 
 Model::Animation *Model::_anim(unsigned index, AnimationModeE m)const
 {
@@ -176,7 +194,7 @@ void Model::deleteAnimation(unsigned index)
 	{		
 		auto dt = undo?undo->removeVertexData():nullptr;
 
-		removeFrameAnimData(fp,ab->_frame_count(),dt,!dt); //release?
+		removeFrameAnimData(fp,ab->_frame_count(),dt);
 	}
 	
 	removeAnimation(index);
@@ -242,15 +260,16 @@ bool Model::setAnimFrameCount(unsigned anim, unsigned count, unsigned where, Fra
 		auto fp = ab->m_frame0+where;
 		auto dt = undo?undo->removeVertexData():nullptr;
 
+		//NEW: Undo/redo pass ins. Removing frames copies them into it
+		//so routines like copyAnimation don't have to generate undo 
+		//data for their copied vertices.
+		assert(!ins||!dt); if(ins) dt = ins;
+
 		if(diff>=0)
 		{
-			//NEW: Gathering the pointers so routines like copyAnimation
-			//don't have to generate undo data for their copied vertices.
-			assert(!ins||!dt);
-
-			insertFrameAnimData(fp,diff,ins?ins:dt,ab);
+			insertFrameAnimData(fp,diff,dt,ab);
 		}
-		else removeFrameAnimData(fp,-diff,dt,!dt); //release?
+		else removeFrameAnimData(fp,-diff,dt);
 	}
 
 	for(auto&ea:ab->m_keyframes)
@@ -570,7 +589,7 @@ bool Model::setFrameAnimVertexCoords(unsigned anim, unsigned frame, unsigned ver
 	
 	auto list = &m_vertices[vertex]->m_frames[fp];
 
-	FrameAnimVertex *fav = list[frame];
+	FrameAnimVertex *fav = list+frame;
 
 	//HACK: Supply default interpolation mode to any
 	//neighboring keyframe
@@ -578,31 +597,28 @@ bool Model::setFrameAnimVertexCoords(unsigned anim, unsigned frame, unsigned ver
 	if(fav->m_interp2020<=InterpolateCopy)
 	{
 		for(auto i=frame;++i<fc;)
-		if(interp2020=list[i]->m_interp2020) 
+		if(interp2020=list[i].m_interp2020) 
 		break;
 		
 		if(fa->m_wrap)
 		{
 			for(unsigned i=0;i<frame;i++)
-			if(interp2020=list[i]->m_interp2020) 
+			if(interp2020=list[i].m_interp2020) 
 			break;
 		}
 		else for(auto i=frame;i-->0;)
-		if(interp2020=list[i]->m_interp2020) 
+		if(interp2020=list[i].m_interp2020) 
 		break;
 		interp2020 = InterpolateLerp;
 	}
 	else interp2020 = fav->m_interp2020;
 
+	double cur[3]; if(!xyz){ fav->getCoord(cur); xyz = cur; }
+
 	Undo<MU_MoveFrameVertex> undo(this,anim,frame);		
-	if(undo) undo->addVertex(vertex,xyz?xyz:fav->m_coord,interp2020,fav);
+	if(undo) undo->addVertex(vertex,xyz,interp2020,fav);
 
-	if(xyz)
-	{
-		fav->m_coord[0] = xyz[0];
-		fav->m_coord[1] = xyz[1];
-		fav->m_coord[2] = xyz[2];		
-	}
+	fav->setCoord(xyz);
 
 	assert(InterpolateKeep!=interp2020);
 	fav->m_interp2020 = interp2020;
@@ -626,12 +642,11 @@ void Model::setQuickFrameAnimVertexCoords(unsigned anim, unsigned frame, unsigne
 	//2022: Can it skip _frame0?
 	//assert(0!=~fa->m_frame0);
 	const auto fp = fa->_frame0(this);	
-	auto list = &m_vertices[vertex]->m_frames[fp];
-	FrameAnimVertex *fav = list[frame];
+	FrameAnimVertex *fav = &m_vertices[vertex]->m_frames[fp+frame];
 
-	fav->m_coord[0] = x;
-	fav->m_coord[1] = y;
-	fav->m_coord[2] = z;
+	fav->m_coord[0] = (float)x;
+	fav->m_coord[1] = (float)y;
+	fav->m_coord[2] = (float)z;
 
 	//invalidateNormals(); //OVERKILL
 
@@ -667,7 +682,7 @@ int Model::copyAnimation(unsigned index, const char *newName)
 			auto p = &ea->m_frames[fp];
 			auto d = &ea->m_frames[fd];
 
-			for(unsigned c=fc;c-->0;d++,p++) **d = **p;
+			for(unsigned c=fc;c-->0;d++,p++) *d = *p;
 		}
 	}		
 
@@ -752,7 +767,7 @@ int Model::splitAnimation(unsigned index, const char *newName, unsigned frame)
 			auto p = &ea->m_frames[fp];
 			auto d = &ea->m_frames[fd];
 
-			for(unsigned c=fc;c-->frame;d++,p++) **d = **p;
+			for(unsigned c=fc;c-->frame;d++,p++) *d = *p;
 		}	
 	}	
 	
@@ -834,7 +849,7 @@ bool Model::joinAnimations(unsigned anim1, unsigned anim2)
 			{
 				v++; //HACK: Increment always.
 
-				auto p = ea->m_frames[fp], d = ea->m_frames[fd];				
+				auto p = &ea->m_frames[fp], d = &ea->m_frames[fd];				
 
 				//Give priority to the second animation since
 				//it's easier to implement for keyframes above.
@@ -845,7 +860,7 @@ bool Model::joinAnimations(unsigned anim1, unsigned anim2)
 					if(d->m_interp2020||!p->m_interp2020) continue;
 				}
 
-				if(undo) undo->addVertex(v,p->m_coord,p->m_interp2020,d,false);			
+				if(undo) undo->addVertex(v,*p,d,false);			
 
 				*d = *p;
 			}
@@ -1010,7 +1025,7 @@ bool Model::mergeAnimations(unsigned anim1, unsigned anim2)
 			{
 				v++; //HACK: Increment always.
 
-				auto p = ea->m_frames[fp], d = ea->m_frames[fd];
+				auto p = &ea->m_frames[fp], d = &ea->m_frames[fd];
 
 				//Give priority to non-Copy data, but prefer
 				//Copy to None too.
@@ -1019,7 +1034,7 @@ bool Model::mergeAnimations(unsigned anim1, unsigned anim2)
 				//would be best to offer a parameter perhaps.
 				if(p->m_interp2020<=InterpolateCopy&&fq!=fp)
 				{
-					auto q = ea->m_frames[fq];
+					auto q = &ea->m_frames[fq];
 
 					if(q->m_interp2020>p->m_interp2020)
 					{
@@ -1029,7 +1044,7 @@ bool Model::mergeAnimations(unsigned anim1, unsigned anim2)
 
 				if(p==d) continue;
 
-				if(undo) undo->addVertex(v,p->m_coord,p->m_interp2020,d,false);			
+				if(undo) undo->addVertex(v,*p,d,false);			
 
 				*d = *p;
 			}
@@ -1236,7 +1251,7 @@ int Model::convertAnimToType(AnimationModeE e, unsigned anim)
 			
 			auto fp = ab->m_frame0; 
 			auto dt = undo?undo->removeVertexData():nullptr;
-			removeFrameAnimData(fp,ab->_frame_count(),dt,!dt); //release?
+			removeFrameAnimData(fp,ab->_frame_count(),dt);
 
 			ab->m_frame0 = ~0; //2022: Adding dedicated MU_VoidFrameAnimation undo for this.
 		}
@@ -1661,39 +1676,20 @@ void Model::insertFrameAnimData(unsigned frame0, unsigned frames, FrameAnimData
 {
 	if(!frames||0==~frame0) return;
 
-	FrameAnimVertex **dp,**dpp; if(data&&!data->empty()) 
+	//2024: data is filled by removeFrameAnimData. If it's empty the
+	//new frames are default values.
+	const FrameAnimVertex *dp = nullptr; if(data&&!data->empty()) 
 	{
 		dp = data->data(); assert(data->size()==m_vertices.size()*frames);
 	}
-	else 
-	{
-		dp = nullptr; if(data) data->reserve(m_vertices.size()*frames);
-	}
 
 	for(auto*ea:m_vertices)
 	{
 		auto it = ea->m_frames.begin()+frame0; if(dp)
 		{
-			dpp = dp+frames;
-
-			ea->m_frames.insert(it,dp,dpp); dp = dpp;
+			ea->m_frames.insert(it,dp,dp+frames); dp+=frames;
 		}
-		else 
-		{
-			//https://gcc.gnu.org/bugzilla/show_bug.cgi?id=55817
-			//it = ea->m_frames.insert(it,frames,nullptr);
-			ea->m_frames.insert(it,frames,nullptr);
-			it = ea->m_frames.begin()+frame0;
-
-			for(auto i=frames;i-->0;)
-			{
-				auto fav = FrameAnimVertex::get();
-
-				if(data) data->push_back(fav);
-
-				*it++ = fav; 
-			}
-		}		
+		else ea->m_frames.insert(it,frames,FrameAnimVertex());
 	}
 
 	for(auto*ea:m_anims) if(~ea->m_frame0) //ANIMMODE_FRAME
@@ -1706,17 +1702,13 @@ void Model::insertFrameAnimData(unsigned frame0, unsigned frames, FrameAnimData
 	}
 }
 
-void Model::removeFrameAnimData(unsigned frame0, unsigned frames, FrameAnimData *data, bool release)
+void Model::removeFrameAnimData(unsigned frame0, unsigned frames, FrameAnimData *data)
 {
 	if(!frames||0==~frame0) return;
 
-	FrameAnimData::iterator jt; if(data)
+	if(data)
 	{
-		assert(data->empty()&&!release);
-
-		data->resize(frames*m_vertices.size());
-
-		jt = data->begin();
+		data->clear(); data->reserve(frames*m_vertices.size());
 	}
 
 	for(auto*ea:m_vertices)
@@ -1724,13 +1716,8 @@ void Model::removeFrameAnimData(unsigned frame0, unsigned frames, FrameAnimData
 		auto it = ea->m_frames.begin()+frame0, itt = it+frames;
 		if(data)
 		{
-			std::copy(it,itt,jt); jt+=frames;
-		}
-		else if(release) //2022 //no undo?
-		{
-			for(auto jt=it;jt<itt;jt++) (*jt)->release();
+			data->insert(data->end(),it,itt);
 		}
-
 		ea->m_frames.erase(it,itt);		
 	}	
 
@@ -2116,7 +2103,7 @@ void Model::validateAnimSkel()const
 
 void Model::calculateSkel()
 {	
-	//LOG_PROFILE(); //???
+	LOG_PROFILE(); //2024
 
 	m_validJoints = true;
 
@@ -2181,7 +2168,7 @@ void Model::calculateAnimSkel()
 
 	if(inJointAnimMode())
 	{
-		//LOG_PROFILE(); //???
+		LOG_PROFILE(); //2024
 
 		validateSkel();
 
@@ -2244,10 +2231,8 @@ void Model::calculateAnim()
 	//or if they were initialized by setCurrentAnimation.
 	//if(inFrameAnimMode()||inSkeletalMode())
 	{
-		for(unsigned v=m_vertices.size();v-->0;)
-		{
-			m_vertices[v]->_resample(*this,v);
-		}
+		//2024: This does Vertex::_resample in batches.
+		_resample_vertices();
 
 		for(unsigned p=m_points.size();p-->0;)
 		{
@@ -2311,6 +2296,128 @@ void Model::Point::_resample(Model &model, unsigned pt)
 		}
 	}
 }
+//2024: These implement _skel_xform_abs(1,...) for calculateAnim on
+//a batch of vertices. The arithmetic is done in the same order so
+//the results are identical. Influences are packed "w" wide.
+static void model_skin_scalar(const double *palette, size_t n, 
+const double *src, const unsigned *cnt, const unsigned *idx, const double *wt, 
+unsigned w, double *const *dst)
+{
+	for(size_t k=0;k<n;k++,src+=4,idx+=w,wt+=w)
+	{
+		double sum[3] = {}, total = 0;
+		for(unsigned j=0;j<cnt[k];j++)
+		{
+			const double *m = palette+idx[j]*16;
+			double vert[3];
+			for(int i=3;i-->0;)
+			vert[i] = src[0]*m[i]+src[1]*m[4+i]+src[2]*m[8+i]+m[12+i];
+			for(int i=3;i-->0;)
+			sum[i]+=wt[j]*vert[i];
+			total+=wt[j];
+		}
+		if(total) //zero divide?
+		{
+			total = 1/total;
+			for(int i=3;i-->0;) dst[k][i] = sum[i]*total;
+		}
+		else for(int i=3;i-->0;) dst[k][i] = src[i];
+	}
+}
+#ifdef MODEL_SKIN_AVX
+//NOTE: Matrix rows are 4 doubles so each row is 1 AVX register. It's
+//left to the compiler not to fuse the multiply/adds since FMA rounds
+//differently (FMA isn't enabled by the "avx" target.)
+MODEL_SKIN_AVX
+static void model_skin_avx(const double *palette, size_t n, 
+const double *src, const unsigned *cnt, const unsigned *idx, const double *wt, 
+unsigned w, double *const *dst)
+{
+	for(size_t k=0;k<n;k++,src+=4,idx+=w,wt+=w)
+	{
+		__m256d x = _mm256_broadcast_sd(src+0);
+		__m256d y = _mm256_broadcast_sd(src+1);
+		__m256d z = _mm256_broadcast_sd(src+2);
+
+		__m256d sum = _mm256_setzero_pd(); double total = 0;
+		for(unsigned j=0;j<cnt[k];j++)
+		{
+			const double *m = palette+idx[j]*16;
+			__m256d v = _mm256_mul_pd(x,_mm256_load_pd(m));
+			v = _mm256_add_pd(v,_mm256_mul_pd(y,_mm256_load_pd(m+4)));
+			v = _mm256_add_pd(v,_mm256_mul_pd(z,_mm256_load_pd(m+8)));
+			v = _mm256_add_pd(v,_mm256_load_pd(m+12));
+			sum = _mm256_add_pd(sum,_mm256_mul_pd(_mm256_set1_pd(wt[j]),v));
+			total+=wt[j];
+		}
+		if(total) //zero divide?
+		{
+			double out[4];
+			_mm256_storeu_pd(out,_mm256_mul_pd(sum,_mm256_set1_pd(1/total)));
+			for(int i=3;i-->0;) dst[k][i] = out[i];
+		}
+		else for(int i=3;i-->0;) dst[k][i] = src[i];
+	}
+}
+#endif
+void Model::_resample_vertices()
+{
+	bool fram = inFrameAnimMode();
+	bool skel = inSkeletalMode();
+
+	//Joint::getSkinMatrix is lazy so it has to be done up front
+	//instead of by the worker threads.
+	size_t jN = skel?m_joints.size():0;
+	DrawArrays::array<double> palette(jN*16);
+	for(size_t j=0;j<jN;j++)
+	{
+		memcpy(&palette[j*16],m_joints[j]->getSkinMatrix().getMatrix(),16*sizeof(double));
+	}
+
+	auto f = model_skin_scalar;
+	#ifdef MODEL_SKIN_AVX
+	static const bool avx = model_skin_has_avx();
+	if(avx) f = model_skin_avx;
+	#endif
+
+	parallel_for(m_vertices.size(),1024,[&](size_t i, size_t iN)
+	{
+		//Batches are kept small so the packed data stays in cache.
+		enum{ batch=256 };
+		double src[batch*4]; unsigned cnt[batch]; double *dst[batch];
+		std::vector<double> wt; std::vector<unsigned> idx;
+
+		for(size_t n;i<iN;i+=n)
+		{
+			n = std::min<size_t>(batch,iN-i);
+
+			unsigned w = 0;
+			if(skel) for(size_t k=0;k<n;k++)
+			{
+				w = std::max(w,(unsigned)m_vertices[i+k]->m_influences.size());
+			}
+			wt.resize(n*w); idx.resize(n*w);
+
+			for(size_t k=0;k<n;k++)
+			{
+				auto *vp = m_vertices[i+k];
+
+				double *s = src+k*4; 
+				if(fram)
+				interpKeyframe(m_currentAnim,m_currentFrame,m_currentTime,i+k,s);
+				else for(int j=3;j-->0;) s[j] = vp->m_coord[j];
+
+				unsigned c = 0; if(skel) for(auto&ea:vp->m_influences)
+				{
+					idx[k*w+c] = ea.m_boneId; wt[k*w+c] = ea.m_weight; c++;
+				}
+				cnt[k] = c; dst[k] = vp->m_kfCoord;
+			}
+
+			f(palette.data(),n,src,cnt,idx.data(),wt.data(),w,dst);
+		}
+	});
+}
 bool Model::_skel_xform_abs(int inv, infl_list &l, Vector &io)
 {
 	auto mf = &Joint::getSkinMatrix;
@@ -2524,7 +2631,7 @@ Model::Interpolate2020E Model::getFrameAnimVertexCoords(unsigned anim, unsigned
 	if(vertex<m_vertices.size())
 	if(~fp&&frame<fa->_frame_count())
 	{	
-		FrameAnimVertex *fav = m_vertices[vertex]->m_frames[fp+frame];
+		const FrameAnimVertex *fav = &m_vertices[vertex]->m_frames[fp+frame];
 		x = fav->m_coord[0];
 		y = fav->m_coord[1];
 		z = fav->m_coord[2];
@@ -2566,7 +2673,7 @@ Model::KeyMask2021E Model::hasKeyframeData(unsigned anim, int incl)const
 		if(fc) //OUCH
 		for(auto*ea:m_vertices) 		
 		for(auto f=fp;f<fd;f++)
-		if(ea->m_frames[f]->m_interp2020)
+		if(ea->m_frames[f].m_interp2020)
 		return KeyMask2021E(incl&(mask|KM_Vertex));
 	}
 	return KeyMask2021E(incl&mask);
@@ -2661,6 +2768,10 @@ void Model::FrameAnimVertex::lerp(const double x[3], const double y[3], double t
 {
 	for(int i=3;i-->0;) z[i] = t*(y[i]-x[i])+x[i]; //DUPLICATE
 }
+void Model::FrameAnimVertex::lerp(const float x[3], const float y[3], double t, double z[3])
+{
+	for(int i=3;i-->0;) z[i] = t*((double)y[i]-x[i])+x[i]; //DUPLICATE
+}
 void Model::Keyframe::slerp(const double qx[4], const double qy[4], double t, double qz[4])
 {
 	auto *yp = qy;
@@ -2684,6 +2795,28 @@ void Model::Keyframe::slerp(const double qx[4], const double qy[4], double t, do
 	for(int i=4;i-->0;)
 	qz[i] = l_t*qx[i]+t*(neg?-qy[i]:qy[i]);	
 }
+static std::mutex model_keyframe_index_mutex; //2024
+void Model::KeyframeList::_index()const
+{
+	if(m_indexed.load(std::memory_order_acquire)==changes) return;
+
+	//Rebuilds are rare so one lock for all lists is enough.
+	std::lock_guard<std::mutex> lock(model_keyframe_index_mutex);
+
+	if(m_indexed.load(std::memory_order_relaxed)==changes) return;
+
+	for(int i=3;i-->0;) m_index[i].clear();
+
+	unsigned k = 0; for(auto*kf:*this)
+	{
+		//NOTE: interpKeyframe has always mapped them this way.
+		unsigned i = kf->m_isRotation;
+		if(i<=KeyScale) m_index[i>>1].push_back(k);
+		k++;
+	}
+
+	m_indexed.store(changes,std::memory_order_release);
+}
 int Model::interpKeyframe(unsigned anim, unsigned frame,
 	unsigned pos, double trans[3])const
 {
@@ -2745,35 +2878,42 @@ int Model::interpKeyframe(unsigned anim, unsigned frame, double time,
 		}
 		else jk_size = 0;
 	   
-		//TODO: Binary search? //FIX ME
+		//2024: This used to scan every key. Now each channel's keys
+		//are binary searched.
 		unsigned first[3] = {};
 		unsigned key[3] = {}, stop[3] = {};
 		unsigned last[3] = {};
-		for(unsigned k=0;k<jk_size;)
+		if(jk_size) 
 		{
-			auto cmp = jk[k++];
-
-			if(mask&cmp->m_isRotation) continue;
+			auto &kl = it->second; kl._index();
 
-			int i = cmp->m_isRotation>>1;
-
-			//if(cmp->m_time<=time)
-			if(cmp->m_frame<=frame)
+			for(int i=0;i<3;i++) if(~mask&1<<i)
 			{
-				if(!first[i]) first[i] = k; 
+				auto &ix = kl.m_index[i];
+				auto *ixd = ix.data();
+				unsigned m = (unsigned)ix.size();
+				if(!m) continue;
 
-				// Less than current time
-				// get latest keyframe for rotation and translation
-				key[i] = k;
-			}
-			else
-			{
-				// Greater than current time
-				// get earliest keyframe for rotation and translation
-				if(!stop[i])
+				//p is how many of the keys are at or before frame.
+				unsigned p = unsigned(std::upper_bound(ixd,ixd+m,frame,[&](unsigned f, unsigned k)
+				{
+					return f<jk[k]->m_frame;
+				})-ixd);
+
+				if(p) 
 				{
+					first[i] = ixd[0]+1; key[i] = ixd[p-1]+1;
+				}
+				if(p<m) 
+				{
+					unsigned k = ixd[p]+1; 
+					
+					last[i] = ixd[m-1]+1;
+
+					// Less than current time
+					// get latest keyframe for rotation and translation
 					if(key[i]) 
-					{						
+					{
 						if(time<=tt[jk[key[i]-1]->m_frame])
 						{
 							stop[i] = key[i]; 
@@ -2782,8 +2922,6 @@ int Model::interpKeyframe(unsigned anim, unsigned frame, double time,
 					}
 					else stop[i] = key[i] = k;
 				}
-
-				last[i] = k;
 			}
 		}
 
@@ -2956,7 +3094,7 @@ int Model::interpKeyframe(unsigned anim, unsigned frame, double time,
 		unsigned frames = ab->_frame_count();
 		for(unsigned kk,k=0;k<frames;)
 		{
-			auto cmp = jk[kk=k++];
+			auto cmp = &jk[kk=k++];
 
 			if(!cmp->m_interp2020) continue;
 
@@ -2998,10 +3136,11 @@ int Model::interpKeyframe(unsigned anim, unsigned frame, double time,
 			if(!stop[i]) stop[i] = (wrap?first:key)[i]; 
 	
 			unsigned frame2;
-			auto p = jk[frame=k-1];
-			auto d = jk[frame2=stop[i]-1];
+			auto p = &jk[frame=k-1];
+			auto d = &jk[frame2=stop[i]-1];
 			double t = 0, cmp = tt[frame];
-			const double *dp,*pp = p->m_coord;
+			double pc[3],dc[3]; p->getCoord(pc);
+			const double *dp,*pp = pc;
 			//RATIONALE: The mode comes from the later keyframe because
 			//there are not modes associated with the base model's data.
 			//If this is unconventional importers should add end frames.
@@ -3013,26 +3152,27 @@ int Model::interpKeyframe(unsigned anim, unsigned frame, double time,
 			//this up here. Unlike vertex-data there's no memory saving.
 			if(InterpolateCopy==p->m_interp2020)
 			{
-				while(k-->0)
+				auto q = p; while(k-->0)
 				{	
-					if(jk[k]->m_interp2020>InterpolateCopy)
+					if(jk[k].m_interp2020>InterpolateCopy)
 					{
-						pp = jk[k]->m_coord; break;
+						q = &jk[k]; break;
 					}
 				}
 				if(k==-1) if(wrap) 
 				{
 					for(k=last[i];k-->0;)
-					if(jk[k]->m_interp2020>InterpolateCopy)
+					if(jk[k].m_interp2020>InterpolateCopy)
 					{
-						pp = jk[k]->m_coord; break;
+						q = &jk[k]; break;
 					}
 				}
 
-				if(pp==p->m_coord)
+				if(q==p)
 				{
 					pp = m_vertices[pos]->m_coord;
 				}
+				else q->getCoord(pc);
 
 				if(!lerp) d = p;
 			}		
@@ -3045,7 +3185,7 @@ int Model::interpKeyframe(unsigned anim, unsigned frame, double time,
 			{			
 				if(lerp&&p!=d)
 				{
-					dp = d->m_coord;
+					d->getCoord(dc); dp = dc;
 					double diff = tt[frame2]-cmp;
 					if(diff<0) diff+=ab->_time_frame();
 					t = (time-cmp)/diff;
@@ -25,6 +25,7 @@
 #include "model.h"
 #include "log.h"
 #include "texture.h"
+#include "parallel.h"
 
 static void model_draw_defaultMaterial()
 {
@@ -403,6 +404,8 @@ static void model_draw_drawProjectionPlane(const Matrix &m)
 
 void Model::draw(unsigned drawOptions, ContextT context, double viewPoint[3])
 {
+	LOG_PROFILE(); //2024
+
 	//https://github.com/zturtleman/mm3d/issues/56
 	drawOptions|=m_drawOptions;
 
@@ -455,6 +458,7 @@ void Model::draw(unsigned drawOptions, ContextT context, double viewPoint[3])
 	//
 	// TODO! if models just use additive blending
 	// bspTree is overkill (two passes can do it)
+	// 2024: See calculateBspTree (SORT_NONE.)
 	//
 	bool alpha = drawOptions&DO_ALPHA&&viewPoint;
 	if(alpha&&!m_validBspTree)
@@ -464,11 +468,6 @@ void Model::draw(unsigned drawOptions, ContextT context, double viewPoint[3])
 		calculateBspTree();
 	}
 
-	for(unsigned t=m_triangles.size();t-->0;)
-	{
-		m_triangles[t]->m_marked = false;
-	}
-
 	glDisable(GL_BLEND);
 	glEnable(GL_LIGHT0);
 	glDisable(GL_LIGHT1);
@@ -515,14 +514,60 @@ void Model::draw(unsigned drawOptions, ContextT context, double viewPoint[3])
 		return infl_wt;
 	};
 
-	if(drawOptions&(DO_VERTEXCOLOR|DO_INFLUENCE)) //2024
+	bool colors = 0!=(drawOptions&(DO_VERTEXCOLOR|DO_INFLUENCE));
+
+	//2024: Draw from retained arrays instead of glBegin/glEnd.
+	int parts = DrawArrays::Coords|DrawArrays::TexCoords|DrawArrays::Indices;
+	parts|=drawOptions&DO_SMOOTHING?DrawArrays::Normals:DrawArrays::FlatNormals;
+	auto &da = _drawArrays(parts);
+
+	if(colors) //2024
 	{
 		glEnable(GL_COLOR_MATERIAL);
+
+		//NOTE: Painting colors doesn't always set ChangeBits
+		//so these are just refilled.
+		da.colors.resize(m_triangles.size()*12);
+		float *c = da.colors.data();
+		for(auto*tp:m_triangles) for(int v=0;v<3;v++,c+=4)
+		{
+			float *f = infl?wt(tp->m_vertexIndices[v]):tp->m_colors[v];
+			memcpy(c,f,4*sizeof(float));
+		}
+		glEnableClientState(GL_COLOR_ARRAY);
+		glColorPointer(4,GL_FLOAT,0,da.colors.data());
 	}
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glVertexPointer(3,GL_FLOAT,0,da.coords.data());
+	glEnableClientState(GL_NORMAL_ARRAY);
+	glNormalPointer(GL_FLOAT,0,(drawOptions&DO_SMOOTHING?da.normals:da.flatNormals).data());
+	glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+	glTexCoordPointer(2,GL_FLOAT,0,da.st.data());
+
+	auto draw_group = [&](unsigned g)
+	{
+		const unsigned *r = &da.ranges[g*4];
+		const unsigned *ii = da.indices.data();
+
+		if(r[1]>r[0])
+		{
+			glDisable(GL_LIGHT1);
+			glEnable(GL_LIGHT0);
+			glDrawElements(GL_TRIANGLES,r[1]-r[0],GL_UNSIGNED_INT,ii+r[0]);
+		}
+		if(r[2]>r[1]) //selected?
+		{
+			glDisable(GL_LIGHT0);
+			glEnable(GL_LIGHT1);
+			glDrawElements(GL_TRIANGLES,r[2]-r[1],GL_UNSIGNED_INT,ii+r[1]);
+
+			//This leaves the lights as drawing in order would.
+			glDisable(GL_LIGHT1); //2020
+			if(!r[3]) glEnable(GL_LIGHT0);
+		}
+	};
 
 	//https://github.com/zturtleman/mm3d/issues/98
-	//bool colorSelected = false;
-	int colorSelected;	
 	for(unsigned g=0;g<m_groups.size();g++)
 	{
 		Group *grp = m_groups[g];
@@ -532,76 +577,11 @@ void Model::draw(unsigned drawOptions, ContextT context, double viewPoint[3])
 		if(alpha&&mi>=0&&m_materials[mi]->needsAlpha())
 		{
 			// Alpha blended groups are drawn by bspTree later
-			for(unsigned i:grp->m_triangleIndices)
-			{
-				m_triangles[i]->m_marked = true;
-			}
 			continue;
 		}
 		else _drawMaterial(d,g);
 
-		//colorSelected = false;
-		colorSelected = -1;
-
-		glBegin(GL_TRIANGLES);
-		for(int i:grp->m_triangleIndices)
-		{
-			auto tp = m_triangles[i]; 
-			
-			tp->m_marked = true;
-
-			if(!tp->visible(d.layers)) continue;
-			
-			if(tp->m_selected)
-			{
-				//if(colorSelected==false)
-				if(colorSelected!=(int)true)
-				{
-					/*if(0==(drawOptions&DO_TEXTURE))
-					{
-						glColor3f(1,0,0); //??? //glColorMaterial?
-					}*/
-					glEnd();
-					glDisable(GL_LIGHT0);
-					glEnable(GL_LIGHT1);
-					glBegin(GL_TRIANGLES);
-					colorSelected = true;
-				}
-			}
-			else
-			{
-				//if(colorSelected==true)
-				if(colorSelected!=(int)false)
-				{
-					/*if(0==(drawOptions&DO_TEXTURE))
-					{
-						glColor3f(0.9f,0.9f,0.9f); //??? //glColorMaterial?
-					}*/
-					glEnd();
-					glDisable(GL_LIGHT1);
-					glEnable(GL_LIGHT0);
-					glBegin(GL_TRIANGLES);
-					colorSelected = false;
-				}						
-			}
-
-			for(int v=0;v<3;v++)
-			{
-				if(drawOptions&(DO_VERTEXCOLOR|DO_INFLUENCE))
-				{
-					float *f = infl?wt(tp->m_vertexIndices[v]):tp->m_colors[v];
-					glColor4fv(f);
-				}
-				glTexCoord2f(tp->m_s[v],tp->m_t[v]);
-				if(drawOptions&DO_SMOOTHING)
-				glNormal3dv(tp->m_normalSource[v]);
-				else glNormal3dv(tp->m_flatSource);
-				glVertex3dv(vl[tp->m_vertexIndices[v]]->m_absSource);
-			}
-		}
-		glEnd();
-
-		if(colorSelected==(int)true) glDisable(GL_LIGHT1); //2020
+		draw_group(g);
 	}
 
 	if(d.texture_matrix!=-1)
@@ -614,75 +594,38 @@ void Model::draw(unsigned drawOptions, ContextT context, double viewPoint[3])
 
 	// Draw ungrouped triangles
 	{
-		colorSelected = -1; //NEW
-
 		model_draw_defaultMaterial();
 
-		glBegin(GL_TRIANGLES);
-		for(auto*tp:m_triangles) if(!tp->m_marked)
-		{
-			tp->m_marked = true;
-
-			if(!tp->visible(d.layers)) continue;
-			
-			if(tp->m_selected)
-			{
-				//if(colorSelected==false)
-				if(colorSelected!=(int)true)
-				{
-				//	glColor3f(1,0,0); //??? //glColorMaterial?
-					glEnd();
-					glDisable(GL_LIGHT0);
-					glEnable(GL_LIGHT1);
-					glBegin(GL_TRIANGLES);
-					colorSelected = true;
-				}
-			}
-			else
-			{
-				//if(colorSelected==true)
-				if(colorSelected!=(int)false)
-				{
-				//	glColor3f(0.9f,0.9f,0.9f); //??? //glColorMaterial?
-					glEnd();
-					glDisable(GL_LIGHT1);
-					glEnable(GL_LIGHT0);
-					glBegin(GL_TRIANGLES);
-					colorSelected = false;
-				}							
-			}
-
-			for(int v=0;v<3;v++)
-			{
-				if(drawOptions&(DO_VERTEXCOLOR|DO_INFLUENCE))
-				{
-					float *f = infl?wt(tp->m_vertexIndices[v]):tp->m_colors[v];
-					glColor4fv(f);
-				}
-				glTexCoord2f(tp->m_s[v],tp->m_t[v]);
-				if(drawOptions&DO_SMOOTHING)
-				glNormal3dv(tp->m_normalSource[v]);
-				else glNormal3dv(tp->m_flatSource);
-				glVertex3dv(vl[tp->m_vertexIndices[v]]->m_absSource);
-			}
-		}
-		glEnd();
-
-		if(colorSelected==(int)true) glDisable(GL_LIGHT1); //2020
+		draw_group(m_groups.size());
 	}
 
+	glDisableClientState(GL_VERTEX_ARRAY);
+	glDisableClientState(GL_NORMAL_ARRAY);
+	glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+	if(colors) glDisableClientState(GL_COLOR_ARRAY);
+
 	if(alpha&&~drawOptions&DO_ALPHA_DEFER_BSP)
 	{
 		// Draw depth-sorted alpha blended polys last
 		//draw_bspTree(drawOptions,context,viewPoint);
 		if(!m_bspTree.empty())
 		{
+			//2024: d.bsp was left nullptr and the blend function
+			//was never set since DO_ALPHA is removed from d.ops.
+			d.ops = drawOptions; d.bsp = this; d.texture_matrix = -1;
+
 			glDepthMask(0);
 			glEnable(GL_BLEND);		
 			m_bspTree.render(viewPoint,d); //drawContext		
 			glDisable(GL_BLEND);
 			glDepthMask(1);
 
+			if(d.texture_matrix!=-1)
+			{	
+				glLoadIdentity();
+				glMatrixMode(GL_MODELVIEW);
+			}
+
 			glDisable(GL_TEXTURE_2D);
 		}
 	}
@@ -699,6 +642,8 @@ void Model::draw(unsigned drawOptions, ContextT context, double viewPoint[3])
 }
 void Model::draw_bspTree(unsigned drawOptions, ContextT context, double viewPoint[3])
 {
+	LOG_PROFILE(); //2024
+
 	if(m_bspTree.empty()) return;
 
 	//https://github.com/zturtleman/mm3d/issues/56
@@ -921,8 +866,6 @@ void Model::drawVertices(float a)
 }
 void Model::_drawPolygons(int pass/*,bool mark*/)
 {	
-	unsigned lv = m_drawingLayers; //2022
-
 	validateAnim();
 
 	int cull = m_drawOptions&DO_BACKFACECULL;
@@ -936,58 +879,147 @@ void Model::_drawPolygons(int pass/*,bool mark*/)
 	//https://github.com/zturtleman/mm3d/issues/96
 	(!pass&&cull?glEnable:glDisable)(GL_CULL_FACE);
 
-	glBegin(GL_TRIANGLES);
-	Vertex **v = m_vertices.data();
-	for(size_t t=m_triangles.size();t-->0;)
+	//2024: This uses draw's arrays.
+	auto &da = _drawArrays(DrawArrays::Coords|DrawArrays::Indices);
+
+	unsigned b = pass?da.polygons_selected:0;
+	unsigned e = pass?(unsigned)da.polygons.size():da.polygons_selected;
+	if(e>b)
 	{
-		Triangle *triangle = m_triangles[t];
-				
-		//triangle->m_marked = true; //???
-		
-		auto *vi = triangle->m_vertexIndices;
-		
-		if(triangle->m_selected)
+		glEnableClientState(GL_VERTEX_ARRAY);
+		glVertexPointer(3,GL_FLOAT,0,da.coords.data());
+		glDrawElements(GL_TRIANGLES,e-b,GL_UNSIGNED_INT,da.polygons.data()+b);
+		glDisableClientState(GL_VERTEX_ARRAY);
+	}
+}
+Model::DrawArrays &Model::_drawArrays(int parts)
+{
+	LOG_PROFILE(); //2024
+
+	if(!m_drawArrays) m_drawArrays = new DrawArrays;
+
+	auto &da = *m_drawArrays;
+
+	#ifdef MM3D_EDIT
+	unsigned bits = da.bits|m_changeBits;
+	#else
+	unsigned bits = ChangeAll;
+	#endif
+	da.bits = 0;
+
+	size_t tN = m_triangles.size();
+	if(da.triangles!=tN||da.groups!=m_groups.size()
+	||da.layers!=m_drawingLayers||da.animationMode!=m_animationMode)
+	{
+		bits = ChangeAll;
+
+		da.triangles = tN; 
+		da.groups = m_groups.size();
+		da.layers = m_drawingLayers;
+		da.animationMode = m_animationMode;
+	}
+
+	const unsigned move = MoveGeometry|AddGeometry
+	|AnimationMode|AnimationSet|AnimationFrame|AnimationProperty;
+	if(bits&move)
+	da.valid&=~DrawArrays::Coords;
+	if(bits&(move|MoveNormals|SetGroup|AddOther))
+	da.valid&=~(DrawArrays::Normals|DrawArrays::FlatNormals);
+	if(bits&(MoveTexture|AddGeometry))
+	da.valid&=~DrawArrays::TexCoords;
+	if(bits&(SelectionChange|AddGeometry|AddOther|SetGroup|RedrawAll))
+	da.valid&=~DrawArrays::Indices;
+
+	int todo = parts&~da.valid; if(!todo) return da;
+
+	da.valid|=todo;
+
+	if(todo&DrawArrays::Indices)
+	{
+		unsigned lv = m_drawingLayers;
+
+		da.indices.clear(); da.ranges.clear();
+
+		auto add = [&](bool sel, unsigned t)->bool
 		{
-			if(pass==0) //continue;
+			auto *tp = m_triangles[t];
+			if(!tp->visible(lv)) return false;
+			if(sel==tp->m_selected) for(unsigned i=0;i<3;i++)
 			{
-				/*2022: Can leverage m_faces for this.
-				if(mark) for(int i=0;i<3;i++)
-				{							
-					v[vi[i]]->m_marked2 = true;
-				}*/
-				continue;
+				da.indices.push_back(t*3+i);
 			}
-		}
-		else
+			return true;
+		};
+		auto group = [&](auto each)
 		{
-			//if(pass==1) continue;
-			if(pass==0) 
+			unsigned last = 0;
+			da.ranges.push_back((unsigned)da.indices.size());
+			each([&](unsigned t){ add(false,t); });
+			da.ranges.push_back((unsigned)da.indices.size());
+			each([&](unsigned t)
 			{
-				/*2022: Can leverage m_faces for this.
-				if(mark) for(int i=0;i<3;i++)
-				{
-					if(!v[vi[i]]->m_selected)
-					v[vi[i]]->m_marked = true;
-				}*/
+				if(add(true,t)) last = m_triangles[t]->m_selected;
+			});
+			da.ranges.push_back((unsigned)da.indices.size());
+			da.ranges.push_back(last);
+		};
+		for(auto*grp:m_groups) group([&](auto f)
+		{
+			for(int t:grp->m_triangleIndices) f(t);
+		});
+		group([&](auto f) //ungrouped
+		{
+			for(unsigned t=0;t<tN;t++) if(m_triangles[t]->m_group<0) f(t);
+		});
+
+		auto &pl = da.polygons; pl.clear();
+		for(int sel=0;sel<2;sel++)
+		{
+			if(sel) da.polygons_selected = (unsigned)pl.size();
+
+			for(unsigned t=(unsigned)tN;t-->0;)
+			{
+				auto *tp = m_triangles[t];
+				if(sel==tp->m_selected&&tp->visible(lv))
+				for(unsigned i=0;i<3;i++) pl.push_back(t*3+i);
 			}
-			else continue;
 		}
+	}
 
-		if(triangle->visible(lv))
-		{			
-			double *vertices[3];
+	if(todo&DrawArrays::Coords) da.coords.resize(tN*9);
+	if(todo&DrawArrays::Normals) da.normals.resize(tN*9);
+	if(todo&DrawArrays::FlatNormals) da.flatNormals.resize(tN*9);
+	if(todo&DrawArrays::TexCoords) da.st.resize(tN*6);
+
+	if(todo&~DrawArrays::Indices)
+	parallel_for(tN,1024,[&](size_t t, size_t tN)
+	{
+		Vertex **vl = m_vertices.data();
 
-			for(int i=0;i<3;i++)
-			{		
-				vertices[i] = v[vi[i]]->m_absSource;
+		for(;t<tN;t++)
+		{
+			auto *tp = m_triangles[t];
+			
+			for(int v=0;v<3;v++) for(int i=0;i<3;i++)
+			{
+				size_t j = t*9+v*3+i;
+
+				if(todo&DrawArrays::Coords)
+				da.coords[j] = (float)vl[tp->m_vertexIndices[v]]->m_absSource[i];
+				if(todo&DrawArrays::Normals)
+				da.normals[j] = (float)tp->m_normalSource[v][i];
+				if(todo&DrawArrays::FlatNormals)
+				da.flatNormals[j] = (float)tp->m_flatSource[i];
 			}
+			if(todo&DrawArrays::TexCoords) for(int v=0;v<3;v++)
+			{
+				da.st[t*6+v*2+0] = tp->m_s[v];
+				da.st[t*6+v*2+1] = tp->m_t[v];
+			}
+		}
+	});
 
-			glVertex3dv(vertices[0]); //glVertex3dv(vertices[1]);
-			glVertex3dv(vertices[1]); //glVertex3dv(vertices[2]);
-			glVertex3dv(vertices[2]); //glVertex3dv(vertices[0]);
-		}		
-	}
-	glEnd();
+	return da;
 }
 
 #ifdef MM3D_EDIT
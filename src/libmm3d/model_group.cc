@@ -142,24 +142,22 @@ void Model::setSelectedAsGroup(unsigned groupNum)
 
 	if(groupNum<m_groups.size())
 	{
-		Group *gp = m_groups[groupNum];
-		while(!gp->m_triangleIndices.empty()) //OVERKILL
-		{
-			//removeTriangleFromGroup(groupNum,gp->m_triangleIndices.front());
-			removeTriangleFromGroup(groupNum,gp->m_triangleIndices.back());
-		}
-
-		// Put selected triangles into group groupNum
+		//2024: Ungroup the unselected triangles and put the selected
+		//triangles into groupNum in one pass.
+		int_list l,gl;
 		for(unsigned t=0;t<m_triangles.size();t++)
 		{
 			auto *tp = m_triangles[t];
 			if(tp->m_selected)
 			{
-				if(tp->m_group>=0)
-				removeTriangleFromGroup(tp->m_group,t);
-				addTriangleToGroup(groupNum,t);
+				l.push_back(t); gl.push_back(groupNum);
+			}
+			else if(tp->m_group==(int)groupNum)
+			{
+				l.push_back(t); gl.push_back(-1);
 			}
 		}
+		setTrianglesGroup(l,gl);
 	}
 }
 
@@ -167,17 +165,94 @@ void Model::addSelectedToGroup(unsigned groupNum)
 {
 	//LOG_PROFILE(); //???
 
-	if(groupNum<m_groups.size())	
-	for(unsigned t=0;t<m_triangles.size();t++)		
+	if(groupNum<m_groups.size())
+	{
+		int_list l; getSelectedTriangles(l);
+
+		setTrianglesGroup(l,groupNum);
+	}
+}
+
+bool Model::setTrianglesGroup(const int_list &l, int groupNum)
+{
+	return setTrianglesGroup(l,int_list(1,groupNum));
+}
+bool Model::setTrianglesGroup(const int_list &l, const int_list &gl)
+{
+	LOG_PROFILE(); //2024
+
+	size_t n = l.size(), gn = gl.size();
+	
+	int tn = (int)m_triangles.size(), grps = (int)m_groups.size();
+
+	if(gn!=1&&gn!=n) 
+	{
+		assert(0); return false;
+	}
+	for(int g:gl) if(g<-1||g>=grps)
+	{
+		log_error("setTrianglesGroup(%d)argument out of range\n",g); 
+		return false;
+	}
+	for(int t:l) if(t<0||t>=tn)
+	{
+		log_error("setTrianglesGroup(%d)argument out of range\n",t);
+		return false;
+	}
+
+	//mark is the size of each affected group's list after it's
+	//filtered, or -1 if it's not affected.
+	int_list mark(grps,-1), moved; 
+	for(size_t i=0;i<n;i++)
 	{
+		int t = l[i], g = gl[gn==1?0:i];
+
 		auto *tp = m_triangles[t];
-		if(tp->m_selected)
+
+		int og = tp->m_group; if(og==g) continue;
+
+		if(og!=-1) mark[og] = 0;
+		if(g!=-1) mark[g] = 0; 
+
+		tp->m_group = g; moved.push_back(t);
+
+		Undo<MU_AddToGroup>(this,t,g,og);
+	}
+	if(moved.empty()) return true;
+
+	if(!std::is_sorted(moved.begin(),moved.end()))
+	{
+		std::sort(moved.begin(),moved.end());
+		moved.erase(std::unique(moved.begin(),moved.end()),moved.end());
+	}
+
+	//Remove the moved triangles from the affected groups, and then
+	//merge them back into their new groups so the lists stay sorted.
+	for(int g=0;g<grps;g++) if(!mark[g])
+	{
+		auto &c = m_groups[g]->m_triangleIndices;
+		c.erase(std::remove_if(c.begin(),c.end(),[&](int t)
 		{
-			if(tp->m_group>=0)
-			removeTriangleFromGroup(tp->m_group,t);
-			addTriangleToGroup(groupNum,t);
-		}	
+			return m_triangles[t]->m_group!=g
+			||std::binary_search(moved.begin(),moved.end(),t);
+
+		}),c.end());
+		mark[g] = (int)c.size();
+	}
+	for(int t:moved) if(int g=m_triangles[t]->m_group;g!=-1)
+	{
+		m_groups[g]->m_triangleIndices.push_back(t);
 	}
+	for(int g=0;g<grps;g++) if(mark[g]>=0)
+	{
+		auto &c = m_groups[g]->m_triangleIndices;
+		std::inplace_merge(c.begin(),c.begin()+mark[g],c.end());
+	}
+
+	m_changeBits |= SetGroup; //SetTexture?
+
+	invalidateNormals();
+	invalidateBspTree(); return true;
 }
 
 bool Model::addTriangleToGroup(unsigned groupNum, unsigned triangleNum, bool undo)
@@ -254,7 +329,10 @@ bool Model::removeTriangleFromGroup(unsigned groupNum, unsigned triangleNum, boo
 		if(*it!=triangleNum)
 		{
 			//it = c.find(triangleNum);
-			it = std::find(c.begin(),c.end(),triangleNum);
+			//it = std::find(c.begin(),c.end(),triangleNum);
+			it = std::lower_bound(c.begin(),c.end(),(int)triangleNum); //2024
+			if(it!=c.end()&&*it!=(int)triangleNum)
+			it = c.end();
 		}
 		if(it!=c.end())
 		{
@@ -379,10 +457,13 @@ int Model::mergeIdenticalGroups()
 	//	if(m_groups[g]->propEqual(*grp2,~Model::PropTriangles))
 		if(m_groups[g]->propEqual(*grp2,~Model::PropTriangles|Model::PropAllSuitable))
 		{
-			for(int i:grp2->m_triangleIndices)
-			{
-				addTriangleToGroup(g,i);
-			}
+			//2024: addTriangleToGroup refuses grouped triangles.
+			//for(int i:grp2->m_triangleIndices)
+			//{
+			//	addTriangleToGroup(g,i);
+			//}
+			int_list l = grp2->m_triangleIndices;
+			setTrianglesGroup(l,g);
 			toRemove.insert(g2);
 
 			merged++;
@@ -25,6 +25,7 @@
 #include "model.h"
 
 #include "log.h"
+#include "parallel.h"
 
 #ifdef MM3D_EDIT
 #include "modelstatus.h"
@@ -32,6 +33,180 @@
 #include "modelundo.h"
 #endif // MM3D_EDIT
 
+//2024: The skeleton's joints are looked up once for the autoSet APIs.
+//autoSetCoordInfluences had searched all joints for the children of
+//every joint (and getBoneVector did so again) making it O(V*J*J) to
+//auto-assign a mesh. The math is the same as getBoneVector so the
+//results don't change.
+struct model_influence_bones
+{
+	struct bone
+	{
+		double coord[3]; int parent; bool selected;
+
+		unsigned children,children_end; //child
+	};
+	std::vector<bone> bones;
+	std::vector<int> child;
+
+	model_influence_bones(const Model &m)
+	{
+		int n = m.getBoneJointCount(); bones.resize(n);
+		std::vector<unsigned> count(n+1);
+		for(int j=0;j<n;j++)
+		{
+			auto &b = bones[j];
+			m.getBoneJointCoords(j,b.coord);
+			b.parent = m.getBoneJointParent(j);
+			b.selected = m.isBoneJointSelected(j);
+			if(b.parent>=0) count[b.parent+1]++;
+		}
+		for(int j=0;j<n;j++) count[j+1]+=count[j];
+		for(int j=0;j<n;j++)
+		{
+			bones[j].children = bones[j].children_end = count[j];
+		}
+		child.resize(count[n]);
+		for(int j=0;j<n;j++) if(bones[j].parent>=0) //ascending
+		{
+			child[bones[bones[j].parent].children_end++] = j;
+		}
+	}
+
+	bool empty()const{ return bones.empty(); }
+
+	int nearest_child(int joint, const double *coord, double *cdist=nullptr)const
+	{
+		int ch = -1; double d,dist = 0;
+		auto &b = bones[joint];
+		for(auto i=b.children;i<b.children_end;i++)
+		{
+			d = distance(bones[child[i]].coord,coord);
+			if(ch<0||d<dist)
+			{
+				ch = child[i]; dist = d;
+			}
+		}
+		if(cdist) *cdist = dist; return ch;
+	}
+
+	//This is Model::getBoneVector given its nearest_child.
+	void vector(int joint, int ch, double vec[3])const
+	{
+		auto &b = bones[joint]; const double *p,*q;
+		if(ch>=0)
+		{
+			p = bones[ch].coord; q = b.coord;
+		}
+		else if(b.parent>=0)
+		{
+			p = b.coord; q = bones[b.parent].coord;
+		}
+		else return;
+		for(int i=3;i-->0;) vec[i] = p[i]-q[i];
+		normalize3(vec);
+	}
+
+	//This is Model::calculateCoordInfluenceWeight.
+	double weight(const double *coord, int joint)const
+	{
+		int ch = nearest_child(joint,coord);
+
+		double bvec[3] = {}, pvec[3];
+		vector(joint,ch,bvec);
+
+		auto *jcoord = bones[joint].coord;
+		for(int i=3;i-->0;)
+		pvec[i] = coord[i]-jcoord[i];
+		normalize3(pvec);
+
+		// get cos from point to bone vector
+		double bcos = dot3(pvec,bvec);
+		bcos = (bcos+1.0)/2.0;
+
+		if(ch<0) return bcos; // no children
+
+		double cvec[3] = {};
+		vector(ch,nearest_child(ch,coord),cvec);
+
+		// get cos from point to child vector
+		auto *ccoord = bones[ch].coord;
+		for(int i=3;i-->0;)
+		pvec[i] = coord[i]-ccoord[i];
+		normalize3(pvec);
+
+		double ccos = dot3(pvec,cvec);
+		ccos = -ccos;
+		ccos = (ccos+1.0)/2.0;
+
+		return bcos*ccos;
+	}
+
+	//This is Model::autoSetCoordInfluences. It returns up to 3 joints.
+	int find(const double *coord, double sensitivity, bool selected, int out[3])const
+	{
+		int bestJoint = -1;
+		int bestChild = -1;
+		double bestChildDist = 0;
+		double bestDist = 0;
+		double bestDot = 0;
+
+		int bcount = (int)bones.size();
+		for(int joint=0;joint<bcount;joint++)
+		if(!selected||bones[joint].selected)
+		{
+			auto *jcoord = bones[joint].coord;
+
+			double dist = distance(coord,jcoord);
+
+			//The bone's direction can only scale dist by 0.667 or 2.
+			if(bestJoint>=0&&dist*0.667>bestDist) continue;
+
+			double chdist;
+			int ch = nearest_child(joint,coord,&chdist);
+
+			double bvec[3] = {}, pvec[3];
+			vector(joint,ch,bvec);
+
+			for(int i=3;i-->0;)
+			pvec[i] = coord[i]-jcoord[i];
+			normalize3(pvec);
+
+			// get cos from point to bone vector
+			double bcos = dot3(pvec,bvec);		
+			dist*= bcos>0?0.667:2; // *= bcos;
+
+			if(bestJoint<0||dist<bestDist)
+			{
+				bestJoint = joint;
+				bestDist = dist;
+				bestChild = ch;
+				bestChildDist = chdist;
+				bestDot = bcos;
+			}
+		}
+
+		int n = 0; if(bestJoint>=0)
+		{
+			out[n++] = bestJoint;
+
+			if(bestChild>=0)		
+			if(bestChildDist*(1-sensitivity)<bestDist*0.5)
+			{
+				out[n++] = bestChild;
+			}
+		
+			int parent = bones[bestJoint].parent;
+			if(parent>0)
+			if((bestDot-1)*sensitivity<-0.080)
+			{
+				out[n++] = parent;
+			}
+		}
+		return n;
+	}
+};
+
 infl_list &Model::getVertexInfluences(unsigned vertex) //NEW
 {		
 	return m_vertices[vertex]->m_influences;
@@ -330,85 +505,62 @@ double Model::calculateCoordInfluenceWeight(const double *coord, unsigned joint)
 {
 	if(joint>=m_joints.size()) return 0;
 
-	int bcount = m_joints.size();
+	return model_influence_bones(*this).weight(coord,joint);
+}
 
-	int child = -1;
-	double cdist = 0.0;
-	for(int b = 0; b<bcount; b++)	
-	if(getBoneJointParent(b)==(int)joint)
-	{
-		double ccoord[3];
-		getBoneJointCoords(b,ccoord);
-		double d = distance(ccoord,coord);
+bool Model::autoSetPositionInfluences(const Position &pos, double sensitivity, bool selected)
+{
+	return autoSetPositionInfluences(pos_list{pos},sensitivity,selected);
+}
+bool Model::autoSetPositionInfluences(const pos_list &l, double sensitivity, bool selected)
+{
+	model_influence_bones bones(*this); if(bones.empty()) return false;
 
-		if(child<0||d<cdist)
+	//2024: The lookups don't change the model so they can be done in
+	//parallel. Only setting the influences has to be done in order.
+	struct result
+	{
+		double coord[3]; int n,joint[3]; double weight[3];
+	};
+	std::vector<result> rl(l.size());
+	parallel_for(l.size(),256,[&](size_t i, size_t iN)
+	{
+		for(;i<iN;i++)
 		{
-			child = b;
-			cdist = d;
-		}
-	}
-
-	double bvec[3] = { 0,0,0 };
-	double pvec[3] = { 0,0,0 };
-
-	getBoneVector(joint,bvec,coord);
+			auto &r = rl[i]; r.n = 0;
 
-	double jcoord[3] = { 0,0,0 };
-	getBoneJointCoords(joint,jcoord);
+			if(!getPositionInfluences(l[i])) continue;
 
-	pvec[0] = coord[0]-jcoord[0];
-	pvec[1] = coord[1]-jcoord[1];
-	pvec[2] = coord[2]-jcoord[2];
+			getPositionCoords(l[i],r.coord);
 
-	normalize3(pvec);
+			r.n = bones.find(r.coord,sensitivity,selected,r.joint);
 
-	// get cos from point to bone vector
-	double bcos = dot3(pvec,bvec);
-	bcos = (bcos+1.0)/2.0;
+			for(int j=r.n;j-->0;)
+			r.weight[j] = bones.weight(r.coord,r.joint[j]);
+		}
+	});
 
-	if(child<0)
+	bool ret = false;
+	for(size_t i=0;i<l.size();i++)
 	{
-		return bcos; // no children
-	}
-
-	double cvec[3] = { 0,0,0 };
-	getBoneVector(child,cvec,coord);
-
-	// get cos from point to child vector
-	double ccoord[3] = { 0,0,0 };
-	getBoneJointCoords(child,ccoord);
-
-	pvec[0] = coord[0]-ccoord[0];
-	pvec[1] = coord[1]-ccoord[1];
-	pvec[2] = coord[2]-ccoord[2];
-
-	normalize3(pvec);
-	double ccos = dot3(pvec,cvec);
-
-	ccos = -ccos;
-	ccos = (ccos+1.0)/2.0;
-
-	return bcos *ccos;
-}
+		auto &r = rl[i]; if(!r.n) continue;
 
-bool Model::autoSetPositionInfluences(const Position &pos, double sensitivity, bool selected)
-{
-	if(!getPositionInfluences(pos)) return false; //2024
+		removeAllPositionInfluences(l[i]);
 
-	double coord[3] = { 0,0,0 };
-	getPositionCoords(pos,coord);
-	int_list l;
-	if(autoSetCoordInfluences(coord,sensitivity,selected,l))
-	{
-		removeAllPositionInfluences(pos);
-		for(int i:l)
+		for(int j=0;j<r.n;j++)
 		{
-			double w = calculatePositionInfluenceWeight(pos,i);
-			setPositionInfluence(pos,i,Model::IT_Auto,w);
+			//NOTE: Changing influences can move an animated vertex and
+			//the weights are calculated from the position at this time.
+			double coord[3] = {};
+			getPositionCoords(l[i],coord);
+			double w = memcmp(coord,r.coord,sizeof(coord))?
+			bones.weight(coord,r.joint[j]):r.weight[j];
+
+			setPositionInfluence(l[i],r.joint[j],Model::IT_Auto,w);
 		}
-		return true;
+		ret = true;
 	}
-	return false;
+	return ret;
 }
 bool Model::autoSetVertexInfluences(unsigned vertex, double sensitivity, bool selected)
 {
@@ -421,80 +573,9 @@ bool Model::autoSetPointInfluences(unsigned point, double sensitivity, bool sele
 
 bool Model::autoSetCoordInfluences(double *coord, double sensitivity, bool selected, int_list &infList)
 {
-	int bcount = m_joints.size(); if(bcount<=0) return false;
-
-	int bestJoint = -1;
-	int bestChild = -1;
-	double bestChildDist = 0;
-	double bestDist = 0;
-	double bestDot  = 0;
-
-	for(int joint=0;joint<bcount;joint++)	
-	if(!selected||m_joints[joint]->m_selected)
-	{
-		int child = -1;
-		double chdist = 0;
-		for(int ch=0;ch<bcount;ch++)		
-		if(getBoneJointParent(ch)==joint)
-		{
-			double ccoord[3];
-			getBoneJointCoords(ch,ccoord);
-			double d = distance(ccoord,coord);
-			if(child<0||d<chdist)
-			{
-				child = ch; chdist = d;
-			}
-		}
-
-		double bvec[3] = {};
-		double pvec[3] = {};
-
-		getBoneVector(joint,bvec,coord);
-
-		double jcoord[3] = {};
-		getBoneJointCoords(joint,jcoord);
-
-		for(int i=3;i-->0;)
-		pvec[i] = coord[i]-jcoord[i];
-		normalize3(pvec);
-
-		double dist = distance(coord,jcoord);
-
-		// get cos from point to bone vector
-		double bcos = dot3(pvec,bvec);		
-		dist*= bcos>0?0.667:2; // *= bcos;
-
-		if(bestJoint<0||dist<bestDist)
-		{
-			bestJoint = joint;
-			bestDist  = dist;
-			bestChild = child;
-			bestChildDist = chdist;
-			bestDot	= bcos;
-		}
-	}
-
-	if(bestJoint>=0)
-	{
-		infList.push_back(bestJoint);
-
-		if(bestChild>=0)		
-		if(bestChildDist*(1-sensitivity)<bestDist*0.5)
-	//	if(!selected||m_joints[bestChild]->m_selected) //2024 //TESTING
-		{
-			infList.push_back(bestChild);
-		}
-		
-		int parent = getBoneJointParent(bestJoint);
-		if(parent>0)
-		if((bestDot-1)*sensitivity<-0.080)
-	//	if(!selected||m_joints[parent]->m_selected) //2024 //TESTING
-		{
-			infList.push_back(parent);
-		}
-		return true;
-	}
-	return false;
+	int joints[3];
+	int n = model_influence_bones(*this).find(coord,sensitivity,selected,joints);
+	infList.insert(infList.end(),joints,joints+n); return n!=0;
 }
 
 void Model::calculateRemainderWeight(const Position &pos)
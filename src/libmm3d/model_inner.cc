@@ -28,28 +28,26 @@
 
 static bool model_inner_recycle = true;
 
-int Model::Vertex::s_allocated = 0;
-int Model::Triangle::s_allocated = 0;
-int Model::Group::s_allocated = 0;
-int Model::Material::s_allocated = 0;
-int Model::Keyframe::s_allocated = 0;
-int Model::Joint::s_allocated = 0;
-int Model::Point::s_allocated = 0;
-int Model::TextureProjection::s_allocated = 0;
-int Model::Animation::s_allocated = 0;
-int Model::FrameAnimVertex::s_allocated = 0;
+std::atomic<int> Model::Vertex::s_allocated(0);
+std::atomic<int> Model::Triangle::s_allocated(0);
+std::atomic<int> Model::Group::s_allocated(0);
+std::atomic<int> Model::Material::s_allocated(0);
+std::atomic<int> Model::Keyframe::s_allocated(0);
+std::atomic<int> Model::Joint::s_allocated(0);
+std::atomic<int> Model::Point::s_allocated(0);
+std::atomic<int> Model::TextureProjection::s_allocated(0);
+std::atomic<int> Model::Animation::s_allocated(0);
 //int Model::FrameAnimPoint::s_allocated = 0;
 
 //FIX THESE: list/pop_front for stack????
-std::vector<Model::Vertex*> Model::Vertex::s_recycle;
-std::vector<Model::Triangle*> Model::Triangle::s_recycle;
-std::vector<Model::Group*> Model::Group::s_recycle;
-std::vector<Model::Material*> Model::Material::s_recycle;
-std::vector<Model::Keyframe*> Model::Keyframe::s_recycle;
-std::vector<Model::Joint*> Model::Joint::s_recycle;
-std::vector<Model::Point*> Model::Point::s_recycle;
-std::vector<Model::Animation*> Model::Animation::s_recycle;
-std::vector<Model::FrameAnimVertex*> Model::FrameAnimVertex::s_recycle;
+thread_local std::vector<Model::Vertex*> Model::Vertex::s_recycle;
+thread_local std::vector<Model::Triangle*> Model::Triangle::s_recycle;
+thread_local std::vector<Model::Group*> Model::Group::s_recycle;
+thread_local std::vector<Model::Material*> Model::Material::s_recycle;
+thread_local std::vector<Model::Keyframe*> Model::Keyframe::s_recycle;
+thread_local std::vector<Model::Joint*> Model::Joint::s_recycle;
+thread_local std::vector<Model::Point*> Model::Point::s_recycle;
+thread_local std::vector<Model::Animation*> Model::Animation::s_recycle;
 //std::vector<Model::FrameAnimPoint*> Model::FrameAnimPoint::s_recycle;
 
 const double EQ_TOLERANCE = 0.00001;
@@ -177,7 +175,7 @@ int Model::Vertex::flush()
 
 void Model::Vertex::stats()
 {
-	log_debug("Vertex: %d/%d\n",s_recycle.size(),s_allocated);
+	log_debug("Vertex: %d/%d\n",s_recycle.size(),(int)s_allocated);
 }
 
 Model::Vertex *Model::Vertex::get(unsigned layer, AnimationModeE am)
@@ -208,8 +206,6 @@ void Model::Vertex::releaseData() //2020
 {
 	m_influences.clear();
 	m_faces.clear();
-	for(auto j=m_frames.size();j-->0;)
-	m_frames[j]->release();
 	m_frames.clear();
 }
 
@@ -249,7 +245,7 @@ bool Model::Vertex::propEqual(const Vertex &rhs, int propBits, double tolerance)
 	{
 		size_t i = 0, iN = m_frames.size();
 		if(iN==rhs.m_frames.size()) 
-		for(;i<iN;i++) if(!m_frames[i]->propEqual(*rhs.m_frames[i],propBits,tolerance))
+		for(;i<iN;i++) if(!m_frames[i].propEqual(rhs.m_frames[i],propBits,tolerance))
 		return false; else return false;
 	}
 
@@ -314,7 +310,7 @@ int Model::Triangle::flush()
 
 void Model::Triangle::stats()
 {
-	log_debug("Triangle: %d/%d\n",s_recycle.size(),s_allocated);
+	log_debug("Triangle: %d/%d\n",s_recycle.size(),(int)s_allocated);
 }
 
 Model::Triangle *Model::Triangle::get(unsigned layer)
@@ -423,7 +419,7 @@ int Model::Group::flush()
 
 void Model::Group::stats()
 {
-	log_debug("Group: %d/%d\n",s_recycle.size(),s_allocated);
+	log_debug("Group: %d/%d\n",s_recycle.size(),(int)s_allocated);
 }
 
 Model::Group *Model::Group::get()
@@ -528,7 +524,7 @@ int Model::Material::flush()
 
 void Model::Material::stats()
 {
-	log_debug("Material: %d/%d\n",s_recycle.size(),s_allocated);
+	log_debug("Material: %d/%d\n",s_recycle.size(),(int)s_allocated);
 }
 
 Model::Material *Model::Material::get()
@@ -652,7 +648,7 @@ int Model::Keyframe::flush()
 
 void Model::Keyframe::stats()
 {
-	log_debug("Keyframe: %d/%d\n",s_recycle.size(),s_allocated);
+	log_debug("Keyframe: %d/%d\n",s_recycle.size(),(int)s_allocated);
 }
 
 Model::Keyframe *Model::Keyframe::get()
@@ -814,7 +810,7 @@ int Model::Joint::flush()
 
 void Model::Joint::stats()
 {
-	log_debug("Joint: %d/%d\n",s_recycle.size(),s_allocated);
+	log_debug("Joint: %d/%d\n",s_recycle.size(),(int)s_allocated);
 }
 
 bool Model::Joint::propEqual(const Joint &rhs, int propBits, double tolerance)const
@@ -925,7 +921,7 @@ int Model::Point::flush()
 
 void Model::Point::stats()
 {
-	log_debug("Point: %d/%d\n",s_recycle.size(),s_allocated);
+	log_debug("Point: %d/%d\n",s_recycle.size(),(int)s_allocated);
 }
 
 bool Model::Point::propEqual(const Point &rhs, int propBits, double tolerance)const
@@ -1032,7 +1028,7 @@ int Model::TextureProjection::flush()
 
 void Model::TextureProjection::stats()
 {
-	log_debug("TextureProjection: %d/%d\n",0,s_allocated);
+	log_debug("TextureProjection: %d/%d\n",0,(int)s_allocated);
 }
 
 bool Model::TextureProjection::propEqual(const TextureProjection &rhs, int propBits, double tolerance)const
@@ -1137,7 +1133,7 @@ int Model::Animation::flush()
 }
 void Model::Animation::stats()
 {
-	log_debug("Animation: %d/%d\n",s_recycle.size(),s_allocated);
+	log_debug("Animation: %d/%d\n",s_recycle.size(),(int)s_allocated);
 }
 bool Model::Animation::propEqual(const Animation &rhs, int propBits, double tolerance)const
 {
@@ -1226,72 +1222,6 @@ bool Model::Animation::propEqual(const Animation &rhs, int propBits, double tole
 	return true;
 }
 
-Model::FrameAnimVertex::FrameAnimVertex()
-{
-	s_allocated++;
-	init();
-}
-
-Model::FrameAnimVertex::~FrameAnimVertex()
-{
-	s_allocated--;
-}
-
-void Model::FrameAnimVertex::init()
-{
-	for(unsigned t=3;t-->0;)
-	{
-		m_coord[t] = 0; //m_normal[t] = 0;
-	}
-	m_interp2020 = InterpolateNone; //NEW (2020)
-}
-
-Model::FrameAnimVertex *Model::FrameAnimVertex::get()
-{
-	if(s_recycle.empty())
-	{
-		return new FrameAnimVertex;
-	}
-	else
-	{
-		FrameAnimVertex *val = s_recycle.back();
-		val->init();
-		s_recycle.pop_back();
-		return val;
-	}
-}
-
-void Model::FrameAnimVertex::release()
-{
-	if(model_inner_recycle)
-	{
-		s_recycle.push_back(this);
-	}
-	else
-	{
-		delete this;
-	}
-}
-
-int Model::FrameAnimVertex::flush()
-{
-	int c = 0;
-	std::vector<FrameAnimVertex*>::iterator it = s_recycle.begin();
-	while(it!=s_recycle.end())
-	{
-		delete *it;
-		it++;
-		c++;
-	}
-	s_recycle.clear();
-	return c;
-}
-
-void Model::FrameAnimVertex::stats()
-{
-	log_debug("FrameAnimVertex: %d/%d\n",s_recycle.size(),s_allocated);
-}
-
 bool Model::FrameAnimVertex::propEqual(const FrameAnimVertex &rhs, int propBits, double tolerance)const
 {	
 	if((propBits &PropType)!=0) //???
@@ -1372,7 +1302,7 @@ int Model::FrameAnimPoint::flush()
 }
 void Model::FrameAnimPoint::stats()
 {
-	log_debug("FrameAnimPoint: %d/%d\n",s_recycle.size(),s_allocated);
+	log_debug("FrameAnimPoint: %d/%d\n",s_recycle.size(),(int)s_allocated);
 }
 bool Model::FrameAnimPoint::propEqual(const FrameAnimPoint &rhs, int propBits, double tolerance)const
 {
@@ -176,7 +176,207 @@ void Model::remapTrianglesIndices(const int_list &map)
 	});
 
 	for(auto*g:m_groups)	
-	for(auto&i:g->m_triangleIndices) i = map[i];
+	{
+		auto &c = g->m_triangleIndices;
+		for(auto&i:c) i = map[i];
+		std::sort(c.begin(),c.end()); //2024: removeTriangleFromGroup
+	}
+}
+
+//Checks desc is descending and in range for remove/insertVertices/Triangles.
+static bool model_insert_desc(const int_list &desc, size_t n, const char *f)
+{
+	unsigned cmp = (unsigned)n; for(unsigned i:desc)
+	{
+		if(i>=cmp){ log_error("%s(%d) index out of range\n",f,i); return false; }
+		cmp = i;
+	}
+	return true;
+}
+void Model::removeVertices(const int_list &desc)
+{
+	size_t n = m_vertices.size(), m = desc.size(); if(m<=1)
+	{
+		if(m) removeVertex(desc[0]); return;
+	}
+	if(!model_insert_desc(desc,n,"removeVertices")) return;
+
+	m_changeBits |= AddGeometry;
+
+	invalidateNormals(); //OVERKILL
+
+	//sub[i] is the number of removed vertices up to and including i.
+	std::vector<unsigned> sub(n);
+	for(int i:desc)
+	{
+		sub[i] = 1;
+
+		if(m_vertices[i]->m_selected) m_changeBits |= SelectionVertices; 
+	}
+	unsigned j = 0, k = 0;
+	for(unsigned i=0;i<n;i++)
+	{
+		if(sub[i]) k++; else m_vertices[j++] = m_vertices[i];
+
+		sub[i] = k;
+	}
+	m_vertices.resize(j);
+
+	for(auto*tp:m_triangles)
+	for(auto&i:tp->m_vertexIndices) i-=i<n?sub[i]:m;
+}
+void Model::insertVertices(const int_list &desc, Vertex *const *vl)
+{
+	size_t n = m_vertices.size(), m = desc.size(); if(m<=1)
+	{
+		if(m) insertVertex(desc[0],vl[0]); return;
+	}
+	if(!model_insert_desc(desc,n+m,"insertVertices")) return;
+
+	invalidateAnim();
+
+	m_changeBits |= AddGeometry;
+
+	for(size_t k=0;k<m;k++)
+	{
+		vl[k]->_source(m_animationMode); //OVERKILL
+
+		if(vl[k]->m_selected) m_changeBits |= SelectionVertices; 
+	}
+
+	invalidateNormals(); //OVERKILL
+
+	//add[i] is how far vertex i moves up. The vertices are placed
+	//from the back so that each is moved once.
+	std::vector<unsigned> add(n);
+	m_vertices.resize(n+m);
+	auto *vp = m_vertices.data();
+	size_t src = n, dst = n+m;
+	for(size_t k=0;k<m;k++)
+	{
+		for(size_t p=desc[k];dst>p+1;)
+		{
+			vp[--dst] = vp[--src]; add[src] = unsigned(dst-src);
+		}
+		vp[--dst] = vl[k];
+	}
+
+	for(auto*tp:m_triangles)
+	for(auto&i:tp->m_vertexIndices) i+=i<n?add[i]:m;
+}
+void Model::removeTriangles(const int_list &desc)
+{
+	size_t n = m_triangles.size(), m = desc.size(); if(m<=1)
+	{
+		if(m) removeTriangle(desc[0]); return;
+	}
+	if(!model_insert_desc(desc,n,"removeTriangles")) return;
+
+	m_changeBits |= AddGeometry;
+
+	invalidateNormals(); //OVERKILL
+
+	//sub[i] is the number of removed triangles up to and including i.
+	std::vector<unsigned> sub(n);
+	bool grouped = false; for(int i:desc)
+	{
+		auto *tp = m_triangles[i]; sub[i] = 1;
+
+		if(tp->m_selected) m_changeBits |= SelectionFaces; 
+
+		//2020: Keep connectivity to help calculateNormals
+		auto &vi = tp->m_vertexIndices;
+		for(int j=3;j-->0;)
+		m_vertices[vi[j]]->_erase_face(tp,j);
+
+		if(tp->m_group!=-1) grouped = true;
+	}
+	unsigned j = 0, k = 0;
+	for(unsigned i=0;i<n;i++)
+	{
+		if(sub[i]) k++; else m_triangles[j++] = m_triangles[i];
+
+		sub[i] = k;
+	}
+	m_triangles.resize(j);
+
+	if(grouped)
+	{
+		m_changeBits |= SetGroup; invalidateBspTree();
+	}
+	for(auto*g:m_groups)
+	{
+		auto &c = g->m_triangleIndices; auto d = c.begin();
+		for(unsigned i:c)
+		if(i>=n) *d++ = i-m;
+		else if(sub[i]==(i?sub[i-1]:0)) *d++ = i-sub[i];
+		c.erase(d,c.end());
+	}
+}
+void Model::insertTriangles(const int_list &desc, Triangle *const *tl)
+{
+	size_t n = m_triangles.size(), m = desc.size(); if(m<=1)
+	{
+		if(m) insertTriangle(desc[0],tl[0]); return;
+	}
+	if(!model_insert_desc(desc,n+m,"insertTriangles")) return;
+
+	invalidateAnim();
+
+	m_changeBits |= AddGeometry;
+
+	bool grouped = false; for(size_t k=m;k-->0;)
+	{
+		auto *tp = tl[k]; tp->_source(m_animationMode); //OVERKILL
+
+		if(tp->m_selected) m_changeBits |= SelectionFaces; 
+
+		//2020: Keep connectivity to help calculateNormals
+		auto &vi = tp->m_vertexIndices;
+		for(int i=3;i-->0;)
+		m_vertices[vi[i]]->m_faces.push_back({tp,i});
+
+		if(tp->m_group!=-1) grouped = true;
+	}
+
+	invalidateNormals(); //OVERKILL
+
+	//add[i] is how far triangle i moves up. The triangles are placed
+	//from the back so that each is moved once.
+	std::vector<unsigned> add(n);
+	m_triangles.resize(n+m);
+	auto *tp = m_triangles.data();
+	size_t src = n, dst = n+m;
+	for(size_t k=0;k<m;k++)
+	{
+		for(size_t p=desc[k];dst>p+1;)
+		{
+			tp[--dst] = tp[--src]; add[src] = unsigned(dst-src);
+		}
+		tp[--dst] = tl[k];
+	}
+
+	for(auto*g:m_groups)
+	for(auto&i:g->m_triangleIndices) i+=(unsigned)i<n?add[i]:m;
+
+	if(grouped) //addTriangleToGroup
+	{
+		m_changeBits |= SetGroup; invalidateBspTree();
+
+		std::vector<size_t> merge(m_groups.size(),~size_t());
+		for(size_t k=m;k-->0;) if(tl[k]->m_group!=-1)
+		{
+			auto g = tl[k]->m_group;
+			auto &c = m_groups[g]->m_triangleIndices;
+			if(merge[g]==~size_t()) merge[g] = c.size();
+			c.push_back(desc[k]);
+		}
+		for(size_t g=merge.size();g-->0;) if(~merge[g])
+		{
+			auto &c = m_groups[g]->m_triangleIndices;
+			std::inplace_merge(c.begin(),c.begin()+merge[g],c.end());
+		}
+	}
 }
 
 void Model::insertGroup(unsigned index, Model::Group *group)
@@ -1216,7 +1216,7 @@ bool Model::mergeAnimations(Model *model)
 
 				for(size_t i=ea.first->_frame_count();i-->0;)
 				{
-					*v->m_frames[bp++] = *w->m_frames[ap++];
+					v->m_frames[bp++] = w->m_frames[ap++];
 				}
 			}
 		}
@@ -1495,11 +1495,11 @@ bool Model::mergeModels(const Model *model, bool textures, AnimationMergeE anima
 					if(frameMap.empty())
 					for(unsigned c=fc;c-->0;d++,p++) 
 					{
-						**d = **p;
+						*d = *p;
 					}
 					else for(unsigned c=0;c<fc;c++,p++)
 					{
-						*d[frameMap[c]] = **p;
+						d[frameMap[c]] = *p;
 					}
 				}			
 			}
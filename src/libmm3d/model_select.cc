@@ -24,6 +24,9 @@
 
 #include "model.h"
 #include "log.h"
+#include "parallel.h"
+
+#include <numeric> //2024 (iota)
 
 #ifdef MM3D_EDIT
 
@@ -366,9 +369,254 @@ bool Model::isPositionSelected(Position p)const
 	return false;
 }
 
+static void model_select_ascending(std::vector<unsigned> &v, size_t n)
+{
+	//Sorting is better for small lists, else mark a byte per index.
+	if(v.size()<n/16)
+	{
+		std::sort(v.begin(),v.end());
+		v.erase(std::unique(v.begin(),v.end()),v.end());
+		return;
+	}
+	std::vector<uint8_t> mark(n); for(unsigned i:v) mark[i] = 1;
+	v.clear();
+	for(size_t i=0;i<n;i++) if(mark[i]) v.push_back((unsigned)i);
+}
+static bool model_select_cells(const Model::ScreenIndex &si, double &x1, double &y1, double &x2, double &y2, int c[4])
+{
+	if(!si.cols) return false;
+
+	//eps covers rounding xy to float.
+	x1-=si.eps; y1-=si.eps; x2+=si.eps; y2+=si.eps;
+
+	double a = (x1-si.x0)*si.inv, b = (y1-si.y0)*si.inv;
+	double d = (x2-si.x0)*si.inv, e = (y2-si.y0)*si.inv;
+	if(!(d>=0&&e>=0&&a<si.cols&&b<si.rows)) return false;
+	c[0] = a>0?(int)a:0; c[2] = d<si.cols?(int)d:si.cols-1;
+	c[1] = b>0?(int)b:0; c[3] = e<si.rows?(int)e:si.rows-1; return true;
+}
+void Model::ScreenIndex::findVertices(double x1, double y1, double x2, double y2, std::vector<unsigned> &out)const
+{
+	if(scan){ out.resize(vertices); std::iota(out.begin(),out.end(),0u); return; }
+
+	out.clear();
+
+	int c[4]; if(model_select_cells(*this,x1,y1,x2,y2,c))
+	for(int r=c[1];r<=c[3];r++)
+	{
+		const unsigned *vc = vertexCells.data()+r*cols;
+		for(unsigned i=vc[c[0]],n=vc[c[2]+1];i<n;i++)
+		{
+			unsigned v = vertexList[i];
+			float x = xy[v*2], y = xy[v*2+1];
+			if(x>=x1&&x<=x2&&y>=y1&&y<=y2) out.push_back(v);
+		}
+	}
+	model_select_ascending(out,vertices);
+}
+void Model::ScreenIndex::findTriangles(double x1, double y1, double x2, double y2, std::vector<unsigned> &out)const
+{
+	if(scan){ out.resize(triangles); std::iota(out.begin(),out.end(),0u); return; }
+
+	out.assign(big.begin(),big.end());
+
+	int c[4]; if(model_select_cells(*this,x1,y1,x2,y2,c))
+	{
+		//Triangles are filed under their lower corner.
+		c[0] = std::max(0,c[0]-spread); c[1] = std::max(0,c[1]-spread);
+
+		for(int r=c[1];r<=c[3];r++)
+		{
+			const unsigned *tc = triangleCells.data()+r*cols;
+			out.insert(out.end(),triangleList.begin()+tc[c[0]],triangleList.begin()+tc[c[2]+1]);
+		}
+	}
+	model_select_ascending(out,triangles);
+}
+const Model::ScreenIndex &Model::_screenIndex(const Matrix &mat, int parts)
+{
+	ScreenIndex *si = nullptr, **lru = m_screenIndices;
+	unsigned stamp = 0;
+	for(auto*&ea:m_screenIndices)
+	{
+		if(!ea){ lru = &ea; continue; }
+
+		stamp = std::max(stamp,ea->stamp);
+
+		if(!memcmp(ea->matrix.getMatrix(),mat.getMatrix(),sizeof(double)*16))
+		{
+			si = ea;
+		}
+		else if(*lru&&ea->stamp<(*lru)->stamp) lru = &ea;
+	}
+	bool fresh = !si; if(fresh)
+	{
+		if(!*lru) *lru = new ScreenIndex;
+
+		si = *lru; si->matrix = mat; si->valid = 0;
+	}
+	si->stamp = stamp+1;
+
+	unsigned bits = si->bits|m_changeBits; si->bits = 0;
+
+	size_t vN = m_vertices.size(), tN = m_triangles.size();
+	if(si->vertices!=vN||si->triangles!=tN||si->animationMode!=m_animationMode)
+	{
+		bits = ChangeAll;
+
+		si->vertices = vN; si->triangles = tN; si->animationMode = m_animationMode;
+	}
+
+	const unsigned move = MoveGeometry|AddGeometry
+	|AnimationMode|AnimationSet|AnimationFrame|AnimationProperty;
+	if(bits&move)
+	{
+		si->valid = 0;
+
+		//Geometry is changing, like when the move tool is dragged, and
+		//that would rebuild the grid on every mouse event. It's cheaper
+		//to visit everything as before until a query finds it settled.
+		if(!fresh){ si->scan = true; return *si; }
+	}
+	si->scan = false;
+
+	if(parts&ScreenIndex::Triangles) parts|=ScreenIndex::Vertices;
+
+	int todo = parts&~si->valid; if(!todo) return *si;
+
+	si->valid|=todo;
+
+	auto &xy = si->xy;
+	auto cell = [&](double x, double y)->unsigned
+	{
+		int c = std::min(si->cols-1,(int)((x-si->x0)*si->inv));
+		int r = std::min(si->rows-1,(int)((y-si->y0)*si->inv));
+		return r*si->cols+c;
+	};
+
+	if(todo&ScreenIndex::Vertices)
+	{
+		xy.resize(vN*2);
+		parallel_for(vN,4096,[&](size_t i, size_t n)
+		{
+			Vector v; for(;i<n;i++)
+			{
+				v.setAll(m_vertices[i]->m_absSource);
+			
+				v[3] = 1; mat.apply4(v);
+
+				//Same as the apply4 in the picking code.
+				double w = v[3]; if(1!=w) 
+				{
+					if(w<=0) v[0] = v[1] = NAN; else v.scale(1/w);
+				}
+				xy[i*2] = (float)v[0]; xy[i*2+1] = (float)v[1];
+			}
+		});
+
+		double x0 = DBL_MAX, y0 = DBL_MAX, x1 = -DBL_MAX, y1 = -DBL_MAX;
+		for(size_t i=0;i<vN;i++) 
+		{
+			float x = xy[i*2], y = xy[i*2+1];
+			if(std::isfinite(x)&&std::isfinite(y))
+			{
+				x0 = std::min<double>(x0,x); x1 = std::max<double>(x1,x);
+				y0 = std::min<double>(y0,y); y1 = std::max<double>(y1,y);
+			}
+		}
+		si->cols = si->rows = 0; si->vertexCells.clear(); si->vertexList.clear(); 
+		
+		if(x0<=x1) //Anything in front?
+		{
+			//About 4 vertices per cell (if spread evenly.) float is good to
+			//24 bits so eps is a few steps of the largest coordinate.
+			double w = x1-x0, h = y1-y0, m = std::max(w,h);
+			double cells = std::max<double>(1,vN/4);
+			double size = w>0&&h>0?sqrt(w*h/cells):m/sqrt(cells);
+			if(!(size>0)) size = 1;
+			size = std::max(size,m/2048);
+			si->cols = (int)(w/size)+1;
+			si->rows = (int)(h/size)+1;
+			si->x0 = x0; si->y0 = y0; si->inv = 1/size;
+			si->eps = std::max({fabs(x0),fabs(x1),fabs(y0),fabs(y1)})/(1<<22)+FLT_MIN;
+
+			auto &vc = si->vertexCells; vc.assign(si->cols*si->rows+1,0);
+			auto &vl = si->vertexList; vl.clear();
+			for(size_t i=0;i<vN;i++)
+			{
+				float x = xy[i*2], y = xy[i*2+1];
+				if(std::isfinite(x)&&std::isfinite(y))
+				{
+					vl.push_back(cell(x,y)); vc[vl.back()+1]++;
+				}
+				else vl.push_back(~0u);
+			}
+			for(size_t i=1;i<vc.size();i++) vc[i]+=vc[i-1];
+			std::vector<unsigned> pos(vc.begin(),vc.end()-1);
+			std::vector<unsigned> key; key.swap(vl); vl.resize(vc.back());
+			for(size_t i=0;i<vN;i++) if(~key[i]) vl[pos[key[i]]++] = (unsigned)i;
+		}
+	}
+
+	if(todo&ScreenIndex::Triangles)
+	{
+		si->triangleCells.clear(); si->triangleList.clear(); si->big.clear();
+		si->spread = 0;
+
+		//Triangles behind the eye are skipped by the picking code. The rest
+		//are keyed by their lower corner's cell and how far they reach. The
+		//grid is at most 2049 square, so the cell fits in 24 bits.
+		enum{ skip=~0u,wide=~1u,big_cells=8 };
+		int cols = si->cols, rows = si->rows;
+		std::vector<unsigned> key(tN,wide);
+		if(cols) parallel_for(tN,4096,[&](size_t t, size_t tN)
+		{
+			for(;t<tN;t++)
+			{
+				auto *vi = m_triangles[t]->m_vertexIndices;
+				float bx0 = xy[vi[0]*2], by0 = xy[vi[0]*2+1], bx1 = bx0, by1 = by0;
+				bool nan = bx0!=bx0;
+				for(int i=1;i<3;i++)
+				{
+					float x = xy[vi[i]*2], y = xy[vi[i]*2+1];
+					nan|=x!=x;
+					bx0 = std::min(bx0,x); bx1 = std::max(bx1,x);
+					by0 = std::min(by0,y); by1 = std::max(by1,y);
+				}
+				if(nan){ key[t] = skip; continue; }
+
+				if(!std::isfinite(bx0)||!std::isfinite(bx1)
+				 ||!std::isfinite(by0)||!std::isfinite(by1)) continue; //wide
+
+				unsigned c0 = cell(bx0,by0), c1 = cell(bx1,by1);
+				int dx = c1%cols-c0%cols, dy = c1/cols-c0/cols;
+				if(dx<=(int)big_cells&&dy<=(int)big_cells)
+				key[t] = c0|std::max(dx,dy)<<24;
+			}
+		});
+		auto &tc = si->triangleCells; tc.assign(cols*rows+1,0);
+		for(unsigned t=0;t<tN;t++) switch(unsigned k=key[t])
+		{
+		case skip: break;
+		case wide: si->big.push_back(t); break;
+		default: 
+			
+			tc[(k&0xffffff)+1]++; si->spread = std::max<int>(si->spread,k>>24);
+		}
+		for(size_t i=1;i<tc.size();i++) tc[i]+=tc[i-1];
+		auto &tl = si->triangleList; tl.resize(tc.back());
+		std::vector<unsigned> pos(tc.begin(),tc.end()-1);
+		for(unsigned t=0;t<tN;t++) if(key[t]<wide)
+		{
+			tl[pos[key[t]&0xffffff]++] = t;
+		}
+	}
+	return *si;
+}
+
 bool Model::selectVerticesInVolumeMatrix(bool how, const Matrix &viewMat, double x1, double y1, double x2, double y2,SelectionTest *test)
 {
-	//LOG_PROFILE(); //???
+	LOG_PROFILE(); //2024
 
 	//beginSelectionDifference(); //OVERKILL!
 
@@ -379,7 +627,11 @@ bool Model::selectVerticesInVolumeMatrix(bool how, const Matrix &viewMat, double
 
 	Vector vert; bool tris = false;
 
-	for(auto*vp:m_vertices) 
+	//2024: Only visit vertices the grid says may be inside.
+	std::vector<unsigned> found;
+	_screenIndex(viewMat,ScreenIndex::Vertices).findVertices(x1,y1,x2,y2,found);
+
+	for(unsigned i:found) if(auto*vp=m_vertices[i])
 	if(vp->m_selected!=how) if(!vp->visible(lv))
 	{
 		for(auto&ea:vp->m_faces)
@@ -432,7 +684,7 @@ bool Model::selectVerticesInVolumeMatrix(bool how, const Matrix &viewMat, double
 
 bool Model::selectTrianglesInVolumeMatrix(bool select, const Matrix &viewMat, double x1, double y1, double x2, double y2, bool connected, SelectionTest *test)
 {
-	//LOG_PROFILE(); //???
+	LOG_PROFILE(); //2024
 
 	//beginSelectionDifference(); //OVERKILL!
 	
@@ -454,7 +706,11 @@ bool Model::selectTrianglesInVolumeMatrix(bool select, const Matrix &viewMat, do
 
 	auto lv = m_primaryLayers;
 
-	for(auto*tri:m_triangles)	
+	//2024: Only visit triangles the grid says may be inside.
+	std::vector<unsigned> found;
+	_screenIndex(viewMat,ScreenIndex::Triangles).findTriangles(x1,y1,x2,y2,found);
+
+	for(unsigned i:found) if(auto*tri=m_triangles[i])
 	if(tri->m_selected!=select&&tri->visible(lv)
 	 &&(!test||(test&&test->shouldSelect(tri))))
 	{
@@ -1142,7 +1398,7 @@ bool Model::selectProjectionsInVolumeMatrix(bool select, const Matrix &viewMat,
 
 bool Model::selectInVolumeMatrix(const Matrix &viewMat, double x1, double y1, double x2, double y2,SelectionTest *test)
 {
-	//LOG_PROFILE(); //???
+	LOG_PROFILE(); //2024
 
 	bool selecting = m_selecting; //2020
 
@@ -1182,7 +1438,7 @@ bool Model::selectInVolumeMatrix(const Matrix &viewMat, double x1, double y1, do
 
 bool Model::unselectInVolumeMatrix(const Matrix &viewMat, double x1, double y1, double x2, double y2,SelectionTest *test)
 {
-	//LOG_PROFILE(); //???
+	LOG_PROFILE(); //2024
 
 	bool selecting = m_selecting; //2020
 
@@ -1363,7 +1619,7 @@ void Model::_selectGroupsFromTriangles_marked2(bool how)
 
 bool Model::invertSelection()
 {
-	//LOG_PROFILE(); //???
+	LOG_PROFILE(); //2024
 
 	beginSelectionDifference(); //OVERKILL!
 
@@ -2196,7 +2452,7 @@ bool Model::selectAllPositions(PositionTypeE pt, bool how)
 }
 void Model::selectAll(bool how)
 {
-	//LOG_PROFILE(); //???
+	LOG_PROFILE(); //2024
 
 	//Joints window calls unselectAllBoneJoints independent
 	//of unslectAll so endSelectionDifference isn't called
@@ -2347,7 +2603,7 @@ void Model::getSelectedInterpolation(unsigned anim, unsigned frame, Get3<Interpo
 		if(ab->_frame_count()) //OUCH
 		for(auto*ea:m_vertices) if(ea->m_selected)
 		{
-			 pred(&(e[0]=ea->m_frames[fp]->m_interp2020));
+			 pred(&(e[0]=ea->m_frames[fp].m_interp2020));
 		}
 	}
 	//if(am==ANIMMODE_JOINT)
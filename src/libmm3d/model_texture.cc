@@ -39,7 +39,7 @@ int Model::s_glTextures = 0;
 
 bool Model::loadTextures(ContextT context)
 {
-	//LOG_PROFILE(); //???
+	LOG_PROFILE(); //2024
 
 	DrawingContext *drawContext = nullptr;
 	if(context)
@@ -28,7 +28,7 @@
 #include "datadest.h"
 #include "log.h"
 
-int ModelFilter::Options::s_allocated = 0;
+std::atomic<int> ModelFilter::Options::s_allocated(0);
 
 ModelFilter::ModelFilter()
 	: m_promptFunc(),
@@ -62,7 +62,7 @@ ModelFilter::Options::~Options()
 
 void ModelFilter::Options::stats()
 {
-	log_debug("Filter Options: %d\n",s_allocated);
+	log_debug("Filter Options: %d\n",(int)s_allocated);
 }
 
 extern bool texmgr_can_read_or_write(const char*,const char*);
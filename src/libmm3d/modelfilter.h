@@ -73,7 +73,7 @@ public:
 
 		virtual ~Options(); // Use release() instead
 
-		static int s_allocated;
+		static std::atomic<int> s_allocated;
 	};
 
 	// To prompt a user for filter options,create a function
@@ -269,6 +269,12 @@ public:
 	int m_texPlaces = 6;
 	int m_normalPlaces = 6;
 
+	//2024: Write each distinct "vt" and "vn" once instead of once per
+	//triangle vertex. m_quantize compares them at the decimal places
+	//they're written with instead of comparing their exact values.
+	bool m_shareCoords = true;
+	bool m_quantize = true;
+
 	virtual bool setNoAnimation(){ return false; } 
 };
 
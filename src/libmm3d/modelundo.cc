@@ -27,7 +27,7 @@
 
 #include "log.h"
 
-int ModelUndo::s_allocated = 0;
+std::atomic<int> ModelUndo::s_allocated(0);
 
 bool MU_TranslateSelected::resume2(const double vec[3])
 {
@@ -477,52 +477,215 @@ void MU_InvertNormals::addTriangles(const int_list &triangles)
 void MU_MoveUnanimated::undo(Model *model)
 {
 	//log_debug("undo move vertex\n"); //???
+
+	_sort();
 	
-	for(auto&ea:m_objects)
-	model->movePositionUnanimated(ea,ea.oldx,ea.oldy,ea.oldz);
+	for(auto&ea:m_runs) for(unsigned i=0;i<ea.count;i++)
+	{
+		double *old = m_old.data()+3*(ea.slot+i);
+
+		model->movePositionUnanimated({ea.pos.type,ea.pos.index+i},old[0],old[1],old[2]);
+	}
 }
 void MU_MoveUnanimated::redo(Model *model)
 {
-	for(auto&ea:m_objects)
-	model->movePositionUnanimated(ea,ea.x,ea.y,ea.z);
+	_sort();
+
+	for(auto&ea:m_runs) for(unsigned i=0;i<ea.count;i++)
+	{
+		double xyz[3]; _get_new(ea.slot+i,xyz);
+
+		model->movePositionUnanimated({ea.pos.type,ea.pos.index+i},xyz[0],xyz[1],xyz[2]);
+	}
 }
 int MU_MoveUnanimated::combine(Undo *u)
 {
 	if(MU_MoveUnanimated*undo=dynamic_cast<MU_MoveUnanimated*>(u))
 	{
-		for(auto&ea:undo->m_objects)
-		addPosition(ea,ea.x,ea.y,ea.z,ea.oldx,ea.oldy,ea.oldz);
+		undo->_sort();
+
+		for(auto&ea:undo->m_runs) for(unsigned i=0;i<ea.count;i++)
+		{
+			double xyz[3]; undo->_get_new(ea.slot+i,xyz);
+
+			double *old = undo->m_old.data()+3*(ea.slot+i);
+
+			addPosition({ea.pos.type,ea.pos.index+i},xyz[0],xyz[1],xyz[2],old[0],old[1],old[2]);
+		}
 		return true;
 	}
 	return false;
 }
 unsigned MU_MoveUnanimated::size()
 {
-	return sizeof(MU_MoveUnanimated)+m_objects.size()*sizeof(MovePrimitiveT);
+	return sizeof(MU_MoveUnanimated)+m_runs.size()*sizeof(Run)
+	+(m_old.size()+m_new.size())*sizeof(double)
+	+m_index.size()*(sizeof(Model::Position)+sizeof(unsigned)+2*sizeof(void*));
 }
 void MU_MoveUnanimated::addPosition(const Model::Position &pos, double x, double y, double z,
 		double oldx, double oldy, double oldz)
 {
-	MovePrimitiveT mv; mv.type = pos.type; mv.index = pos.index; //C++
+	double xyz[3] = {x,y,z};
 
 	// Modify an object we already have
-	unsigned index;
-	if(m_objects.find_sorted(mv,index))
+	unsigned slot = _find(pos);
+	if(slot!=~0u)
 	{
-		m_objects[index].x = x;
-		m_objects[index].y = y;
-		m_objects[index].z = z;
-		return;
+		return _set_new(slot,xyz,false);
 	}
 
 	// Not found, add object information
-	mv.x		 = x;
-	mv.y		 = y;
-	mv.z		 = z;
-	mv.oldx	 = oldx;
-	mv.oldy	 = oldy;
-	mv.oldz	 = oldz;
-	m_objects.insert_sorted(mv,index);
+	slot = (unsigned)m_old.size()/3;
+	m_old.push_back(oldx);
+	m_old.push_back(oldy);
+	m_old.push_back(oldz);
+	_insert(pos,slot);
+	_set_new(slot,xyz,true);
+}
+unsigned MU_MoveUnanimated::_find(const Model::Position &pos)
+{
+	size_t n = m_runs.size(); if(!n) return ~0u;
+
+	auto in = [&](size_t r)->unsigned
+	{
+		auto &ea = m_runs[r];
+		if(ea.pos.type==pos.type&&pos.index>=ea.pos.index)
+		{
+			unsigned i = pos.index-ea.pos.index;
+			if(i<ea.count){ m_hint = (unsigned)r; return ea.slot+i; }
+		}
+		return ~0u;
+	};
+
+	//Callers usually go over the same objects in the same order.
+	unsigned slot;
+	if(m_hint<n&&~0u!=(slot=in(m_hint))) return slot;
+	if(m_hint+1<n&&~0u!=(slot=in(m_hint+1))) return slot;
+	if(m_hint>=n||pos<m_runs[m_hint].pos) if(~0u!=(slot=in(0))) return slot;
+
+	if(!m_index.empty())
+	{
+		auto it = m_index.find(pos);
+		return it==m_index.end()?~0u:it->second;
+	}
+	auto it = std::upper_bound(m_runs.begin(),m_runs.end(),pos,
+	[](const Model::Position &a, const Run &b){ return a<b.pos; });
+	return it==m_runs.begin()?~0u:in(it-m_runs.begin()-1);
+}
+void MU_MoveUnanimated::_insert(const Model::Position &pos, unsigned slot)
+{
+	//Out of order objects go on the end and m_index is used to look
+	//them up until _sort is called.
+	if(!m_runs.empty()&&pos<m_runs.back().pos&&m_index.empty())
+	{
+		m_index.reserve(m_old.size()/3);
+		for(auto&ea:m_runs) for(unsigned i=0;i<ea.count;i++)
+		m_index[{ea.pos.type,ea.pos.index+i}] = ea.slot+i;
+	}
+	if(!m_index.empty()) m_index[pos] = slot;
+
+	if(!m_runs.empty()) //Extend run?
+	{
+		auto &ea = m_runs.back();
+		if(ea.pos.type==pos.type&&ea.pos.index+ea.count==pos.index
+		&&ea.slot+ea.count==slot)
+		{
+			ea.count++; m_hint = (unsigned)m_runs.size()-1; return;
+		}
+	}
+	m_hint = (unsigned)m_runs.size(); m_runs.push_back({pos,slot,1}); 
+}
+void MU_MoveUnanimated::_sort()
+{
+	if(m_index.empty()) return;
+
+	std::sort(m_runs.begin(),m_runs.end(),[](const Run &a, const Run &b)
+	{
+		return a.pos<b.pos;
+	});
+	size_t j = 0; for(size_t i=1;i<m_runs.size();i++)
+	{
+		auto &a = m_runs[j], &b = m_runs[i];
+		if(a.pos.type==b.pos.type&&a.pos.index+a.count==b.pos.index
+		&&a.slot+a.count==b.slot)
+		{
+			a.count+=b.count;
+		}
+		else m_runs[++j] = b;
+	}
+	m_runs.resize(j+1); m_hint = 0;
+
+	decltype(m_index)().swap(m_index);
+}
+void MU_MoveUnanimated::_get_new(unsigned slot, double xyz[3])
+{
+	if(!m_new.empty())
+	{
+		memcpy(xyz,m_new.data()+3*slot,3*sizeof(double));
+	}
+	else
+	{
+		double *old = m_old.data()+3*slot;
+		double *d = m_delta[slot<m_split?0:1];
+		for(int i=3;i-->0;) xyz[i] = old[i]+d[i];
+	}
+}
+void MU_MoveUnanimated::_set_new(unsigned slot, const double xyz[3], bool append)
+{
+	if(m_new.empty())
+	{
+		double *old = m_old.data()+3*slot, d[3],cmp[3];
+
+		for(int i=3;i-->0;) d[i] = xyz[i]-old[i];
+		for(int i=3;i-->0;) cmp[i] = old[i]+d[i];
+
+		//The offset has to reproduce the coordinates bit for bit.
+		if(!memcmp(cmp,xyz,sizeof(cmp)))
+		{
+			unsigned n = (unsigned)m_old.size()/3;
+
+			bool a = !memcmp(d,m_delta[0],sizeof(d));
+			bool b = !memcmp(d,m_delta[1],sizeof(d));
+
+			if(append)
+			{
+				if(slot==0) //First?
+				{
+					memcpy(m_delta[0],d,sizeof(d)); m_split = 1; return;
+				}
+				if(m_split==slot) //Only m_delta[0] so far?
+				{
+					if(a) m_split++; 
+					else memcpy(m_delta[1],d,sizeof(d)); return;
+				}
+				if(b) return;
+			}
+			else if(slot<m_split?a:b)
+			{
+				return;
+			}
+			else if(slot==m_split&&a) //Continuing m_delta[0]?
+			{
+				m_split++; return;
+			}
+			else if(slot==0&&m_split==n) //Starting over?
+			{
+				memcpy(m_delta[1],m_delta[0],sizeof(d));
+				memcpy(m_delta[0],d,sizeof(d)); m_split = 1; return;
+			}
+		}
+		_expand();
+	}
+	else if(append) m_new.resize(m_old.size());
+
+	memcpy(m_new.data()+3*slot,xyz,3*sizeof(double));
+}
+void MU_MoveUnanimated::_expand()
+{
+	size_t n = m_old.size()/3;
+	std::vector<double> tmp(3*n);
+	for(unsigned i=0;i<n;i++) _get_new(i,tmp.data()+3*i);
+	m_new.swap(tmp);
 }
 
 void MU_SetObjectUnanimated::undo(Model *model)
@@ -675,19 +838,29 @@ void MU_AddToGroup::undo(Model *model)
 {
 	//log_debug("undo add to group\n"); //???
 
-	for(auto&ea:m_list)
-	{
-		if(ea.groupOld<0) model->ungroupTriangle(ea.triangleNum);
-		else model->addTriangleToGroup(ea.groupOld,ea.triangleNum);
-	}
+	_apply(model,true);
 }
 void MU_AddToGroup::redo(Model *model)
 {
-	for(auto&ea:m_list)	
+	_apply(model,false);
+}
+void MU_AddToGroup::_apply(Model *model, bool undo)
+{
+	//2024: setTrianglesGroup updates each group once instead
+	//of searching its list for every triangle.
+	/*for(auto&ea:m_list)	
 	{
 		if(ea.groupNum<0) model->ungroupTriangle(ea.triangleNum);
 		else model->addTriangleToGroup(ea.groupNum,ea.triangleNum);
+	}*/
+	int_list l,gl; 
+	l.reserve(m_list.size()); gl.reserve(m_list.size());
+	for(auto&ea:m_list)
+	{
+		l.push_back(ea.triangleNum);
+		gl.push_back(undo?ea.groupOld:ea.groupNum);
 	}
+	model->setTrianglesGroup(l,gl);
 }
 int MU_AddToGroup::combine(Undo *u)
 {
@@ -705,12 +878,13 @@ unsigned MU_AddToGroup::size()
 }
 bool MU_AddToGroup::resume2(unsigned tri, int grp, int old)
 {
-	for(auto&ea:m_list) if(ea.triangleNum==tri)
+	AddToGroupT atg = {tri,grp,old}; unsigned i;
+
+	if(m_list.find_sorted(atg,i))
 	{
-		ea.groupNum = grp; return true;
+		m_list[i].groupNum = grp; return true;
 	}
-
-	m_list.push_back({tri,grp,old}); return true;
+	m_list.insert_sorted(atg,i); return true;
 }
 
 void MU_SetLightProperties::undo(Model *model)
@@ -1034,24 +1208,6 @@ int MU_SetAnimFrameCount::combine(Undo *u)
 {
 	return CC_Stop; //???
 }
-void MU_SetAnimFrameCount::undoRelease()
-{	
-	if(m_oldCount>m_newCount)
-	{
-		//log_debug("releasing animation in undo\n");
-
-		for(auto*ea:m_vertices) ea->release();
-	}
-}
-void MU_SetAnimFrameCount::redoRelease()
-{	
-	if(m_oldCount<m_newCount)
-	{
-		//log_debug("releasing animation in redo\n");
-
-		for(auto*ea:m_vertices) ea->release();
-	}	
-}
 unsigned MU_SetAnimFrameCount::size()
 {
 	size_t sz = m_timetable.size()*sizeof(double);
@@ -1338,18 +1494,25 @@ unsigned MU_MoveFrameVertex::size()
 	return sizeof(MU_MoveFrameVertex)+m_vertices.size()*sizeof(MoveFrameVertexT);
 }
 void MU_MoveFrameVertex::addVertex(int v, const double xyz[3], 
-		Model::Interpolate2020E e, Model::FrameAnimVertex *old, bool sort)
+		Model::Interpolate2020E e, const Model::FrameAnimVertex *old, bool sort)
 {
 	MoveFrameVertexT mv;
 	mv.number = v;
 	memcpy(mv.xyz,xyz,sizeof(mv.xyz));	
-	memcpy(mv.old,old->m_coord,sizeof(mv.old));
+	old->getCoord(mv.old);
 	mv.e = e;
 	mv.olde = old->m_interp2020;
 
 	if(sort) addVertex(mv);
 	else m_vertices.push_back(mv); //2020
 }
+void MU_MoveFrameVertex::addVertex(int v, const Model::FrameAnimVertex &cur,
+		const Model::FrameAnimVertex *old, bool sort)
+{
+	double xyz[3]; cur.getCoord(xyz);
+
+	addVertex(v,xyz,cur.m_interp2020,old,sort);
+}
 void MU_MoveFrameVertex::addVertex(MoveFrameVertexT &mv)
 {
 	// Modify a vertex we already have
@@ -1564,8 +1727,6 @@ void MU_DeleteAnimation::undoRelease()
 	//log_debug("releasing animation in undo\n");
 
 	if(m_animp) m_animp->release();
-	
-	for(auto*ea:m_vertices) ea->release();
 }
 unsigned MU_DeleteAnimation::size()
 {
@@ -1626,12 +1787,6 @@ int MU_VoidFrameAnimation::combine(Undo *u)
 {
 	return CC_Stop;
 }
-void MU_VoidFrameAnimation::undoRelease()
-{
-	//log_debug("releasing animation in undo\n");
-
-	for(auto*ea:m_vertices) ea->release();
-}
 unsigned MU_VoidFrameAnimation::size()
 {
 	unsigned sz = sizeof(*this);
@@ -1972,11 +2127,11 @@ void MU_InterpolateSelected::_do(Model *model, bool redoing)
 	auto fa = model->m_anims[m_anim];
 	auto fp = fa->m_frame0+m_frame;
 	auto e = m_e; //optimizing
-	auto &vl = model->getVertexList();
+	auto &vl = model->m_vertices;
 	for(auto&ea:m_eold)
 	{
 		auto vp = vl[ea.v];
-		auto vf = vp->m_frames[fp];
+		auto vf = &vp->m_frames[fp];
 		auto &cmp = vf->m_interp2020;
 
 		if(redoing)
@@ -1988,7 +2143,9 @@ void MU_InterpolateSelected::_do(Model *model, bool redoing)
 				assert(m_anim==model->getCurrentAnimation()); //2021
 				model->validateAnim();
 				memcpy(vf->m_coord,vp->m_kfCoord,sizeof(vp->m_kfCoord));*/
-				model->interpKeyframe(m_anim,m_frame,ea.v,vf->m_coord);
+				double coord[3];
+				model->interpKeyframe(m_anim,m_frame,ea.v,coord);
+				vf->setCoord(coord);
 			}
 
 			cmp = e;
@@ -2204,6 +2361,8 @@ unsigned MU_AssocUtility::size()
 
 void MU_Add::undo(Model *model)
 {
+	if(_batch(model,m_op>0,true)) return; //2024
+
 	void(Model::*f)(int,void*),(Model::*g)(int);
 	if(_fg(f,g)) if(m_op>0)
 	{
@@ -2218,6 +2377,8 @@ void MU_Add::undo(Model *model)
 }
 void MU_Add::redo(Model *model)
 {
+	if(_batch(model,m_op<0,false)) return; //2024
+
 	void(Model::*f)(int,void*),(Model::*g)(int);
 	if(_fg(f,g)) if(m_op>0)
 	{
@@ -2277,6 +2438,45 @@ bool MU_Add::_fg(void(Model::*&f)(int,void*), void(Model::*&g)(int))
 	}
 	return true;
 }
+bool MU_Add::_batch(Model *model, bool remove, bool reverse)
+{
+	//2024: Vertices and triangles are done in runs that Model can do
+	//in one pass. Removing is done in runs of descending indices and
+	//inserting in runs of ascending indices.
+	bool v = abs(m_op)==Model::PartVertices; 
+	if(!v&&abs(m_op)!=Model::PartFaces) return false;
+
+	int_list l; std::vector<void*> pl;
+	size_t n = m_list.size();
+	auto *p = m_list.data(); if(reverse) p+=n-1;
+	int d = reverse?-1:1;
+	for(size_t i=0,j;i<n;i=j)
+	{
+		l.clear(); pl.clear();
+		for(j=i;j<n;j++)
+		{
+			auto &r = p[d*(ptrdiff_t)j];
+			if(j>i)
+			{
+				unsigned cmp = l.back();
+				if(remove?r.index>=cmp:r.index<=cmp) break;
+			}
+			l.push_back(r.index); pl.push_back(r.ptr);
+		}
+		if(remove)
+		{
+			if(v) model->removeVertices(l); else model->removeTriangles(l);
+		}
+		else
+		{
+			std::reverse(l.begin(),l.end()); std::reverse(pl.begin(),pl.end());
+
+			if(v) model->insertVertices(l,(Model::Vertex**)pl.data());
+			else model->insertTriangles(l,(Model::Triangle**)pl.data());
+		}
+	}
+	return true;
+}
 void MU_Add::_release()
 {
 	switch(abs(m_op))
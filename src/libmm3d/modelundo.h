@@ -37,7 +37,7 @@ public:
 	enum{ resume=true };
 	bool resume2(){ return true; } //YUCK
 
-	static int s_allocated;
+	static std::atomic<int> s_allocated;
 	ModelUndo(){ s_allocated++; };
 	virtual ~ModelUndo(){ s_allocated--; };
 		
@@ -362,6 +362,8 @@ class MU_MoveUnanimated : public ModelUndo
 {
 public:
 
+	MU_MoveUnanimated():m_delta(),m_split(),m_hint(){}
+
 	void undo(Model *);
 	void redo(Model *);
 	int combine(Undo *);
@@ -373,20 +375,33 @@ public:
 
 private:
 
-	struct MovePrimitiveT : Model::Position
+	//2024: This had kept a sorted_list of 56B records (Position plus
+	//new/old xyz) that had to be shifted to insert out of order. Now
+	//consecutive indices share a Run, and the new coordinates aren't
+	//stored if they're all exactly the old ones plus one offset (e.g.
+	//snapping to a grid.) There are two offsets so that a drag that 
+	//revisits everything in the same order can change it as it goes.
+
+	struct Run
 	{
-		double x;
-		double y;
-		double z;
-		double oldx;
-		double oldy;
-		double oldz;
+		Model::Position pos; unsigned slot,count; //m_old[3*slot]
 	};
+	std::vector<Run> m_runs; //sorted by pos (see _sort)
+
+	std::unordered_map<Model::Position,unsigned,Model::Position::hash> m_index;
+
+	std::vector<double> m_old,m_new; //m_new is empty if translating
 
-	//TODO: Use unsorted_map/Position.
-	typedef sorted_list<MovePrimitiveT> MovePrimitiveList;
+	double m_delta[2][3]; //slots before/after m_split
+	unsigned m_split;
+	unsigned m_hint; //m_runs
 
-	MovePrimitiveList m_objects;
+	unsigned _find(const Model::Position&);
+	void _insert(const Model::Position&, unsigned slot);
+	void _sort();
+	void _get_new(unsigned slot, double xyz[3]);
+	void _set_new(unsigned slot, const double xyz[3], bool append);
+	void _expand();
 };
 
 //TODO: Can replace with MU_SwapStableMem?
@@ -519,8 +534,19 @@ private:
 	{
 		unsigned triangleNum;
 		int groupNum,groupOld;		
+		bool operator<(const struct _AddToGroup_t &rhs)const
+		{
+			return triangleNum<rhs.triangleNum;
+		}
+		bool operator==(const struct _AddToGroup_t &rhs)const
+		{
+			return triangleNum==rhs.triangleNum;
+		}
 	} AddToGroupT;
-	typedef std::vector<AddToGroupT> AddToGroupList;
+	//2024: This was a std::vector searched by resume2.
+	typedef sorted_list<AddToGroupT> AddToGroupList;
+
+	void _apply(Model*, bool undo);
 
 	AddToGroupList m_list;
 };
@@ -748,9 +774,6 @@ public:
 	void redo(Model *);
 	int combine(Undo *);
 
-	void undoRelease();
-	void redoRelease();
-
 	unsigned size();
 
 	MU_SetAnimFrameCount(unsigned animNum, unsigned newCount, unsigned oldCount, unsigned where);
@@ -1026,7 +1049,9 @@ public:
 	:m_anim(anim),m_frame(frame){}
 
 	void addVertex(int v, const double xyz[3],
-	Model::Interpolate2020E e, Model::FrameAnimVertex *old, bool sort=true);
+	Model::Interpolate2020E e, const Model::FrameAnimVertex *old, bool sort=true);
+	void addVertex(int v, const Model::FrameAnimVertex &cur,
+	const Model::FrameAnimVertex *old, bool sort=true);
 
 	bool resume2(unsigned anim, unsigned frame)
 	{
@@ -1221,8 +1246,6 @@ public:
 
 	int combine(Undo *);
 
-	void undoRelease();
-
 	unsigned size();
 
 	Model::FrameAnimData *removeVertexData(){ return &m_vertices; }
@@ -1791,6 +1814,7 @@ protected:
 
 	void _release();
 	bool _fg(void(Model::*&f)(int,void*), void(Model::*&g)(int));
+	bool _batch(Model*, bool remove, bool reverse);
 };
 class MU_Delete : public MU_Add
 {
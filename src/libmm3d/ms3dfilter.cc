@@ -286,6 +286,7 @@ Model::ModelErrorE Ms3dFilter::readFile(Model *model, const char *const filename
 	// TODO verify file size vs. numVertices
 
 	int_list vertexJoints;
+	std::vector<double> coords(numVertices*3); //2024
 	for(t = 0; t<numVertices; t++)
 	{
 		MS3DVertex vertex;
@@ -296,11 +297,13 @@ Model::ModelErrorE Ms3dFilter::readFile(Model *model, const char *const filename
 		m_src->read(vertex.m_boneId);
 		m_src->read(vertex.m_refCount);
 				
-		model->addVertex(vertex.m_vertex[0],vertex.m_vertex[1],vertex.m_vertex[2]);
+		for(int i=3;i-->0;) coords[t*3+i] = vertex.m_vertex[i];
 
 		vertexJoints.push_back(vertex.m_boneId==0xFF?-1:vertex.m_boneId);
 	}
 
+	model->addVertices(numVertices,coords.data());
+
 	uint16_t numTriangles = 0;
 	m_src->read(numTriangles);
 
@@ -309,6 +312,9 @@ Model::ModelErrorE Ms3dFilter::readFile(Model *model, const char *const filename
 		return Model::ERROR_UNEXPECTED_EOF;
 	}
 
+	std::vector<unsigned> indices(numTriangles*3); //2024
+	std::vector<float> st(numTriangles*6);
+
 	for(t = 0; t<numTriangles; t++)
 	{
 		MS3DTriangle triangle;
@@ -342,14 +348,16 @@ Model::ModelErrorE Ms3dFilter::readFile(Model *model, const char *const filename
 			return Model::ERROR_BAD_DATA;
 		}		
 
-		model->addTriangle(triangle.m_vertexIndices[0],triangle.m_vertexIndices[1],triangle.m_vertexIndices[2]);
 		for(int i=0;i<3;i++)
 		{
+			indices[t*3+i] = triangle.m_vertexIndices[i];
+
 			// Need to invert the T coord, since milkshape seems to store it
 			// upside-down.
-			model->setTextureCoords(t,i,triangle.m_s[i],1-triangle.m_t[i]);
+			st[t*6+i*2] = triangle.m_s[i]; st[t*6+i*2+1] = 1-triangle.m_t[i];
 		}
 	}
+	model->addTriangles(numTriangles,indices.data(),st.data());
 
 	uint16_t numGroups = 0;
 	m_src->read(numGroups);
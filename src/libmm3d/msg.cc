@@ -45,16 +45,38 @@ extern "C" void msg_register_prompt
 	msg_user_warn_prompt = warnmsg; msg_user_err_prompt = errmsg;
 }
 
+static thread_local msg_list *msg_captured = nullptr; //2024
+
+extern void msg_capture(msg_list *l)
+{
+	msg_captured = l;
+}
+extern void msg_replay(const msg_list &l)
+{
+	for(auto&ea:l) switch(ea.first)
+	{
+	case 'i': msg_info(ea.second.c_str()); break;
+	case 'w': msg_warning(ea.second.c_str()); break;
+	default: msg_error(ea.second.c_str()); break;
+	}
+}
+
 extern "C" void msg_info(const char *str)
 {
+	if(msg_captured){ msg_captured->push_back({'i',str}); return; }
+
 	msg_user_info?msg_user_info(str):(void)printf("info: %s\n",str);
 }
 extern "C" void msg_warning(const char *str)
 {
+	if(msg_captured){ msg_captured->push_back({'w',str}); return; }
+
 	msg_user_warn?msg_user_warn(str):(void)printf("warning: %s\n",str);
 }
 extern "C" void msg_error(const char *str)
 {
+	if(msg_captured){ msg_captured->push_back({'e',str}); return; }
+
 	msg_user_err?msg_user_err(str):(void)printf("error: %s\n",str);
 }
 
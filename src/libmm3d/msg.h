@@ -78,6 +78,14 @@ extern "C" char msg_error_prompt(  const char *str, const char *opts = "Ync");
 extern "C" char msg_warning_prompt(const char *str, const char *opts = "Ync");
 extern "C" char msg_info_prompt(	const char *str, const char *opts = "Ync");
 
+//2024: While a thread has a capture list the messages it sends go
+//into the list instead of being shown, so that msg_replay can show
+//them in order later. cmdline.cc uses this for --jobs. (Prompts are
+//still shown right away.)
+typedef std::vector<std::pair<char,std::string>> msg_list; //'i','w','e'
+extern void msg_capture(msg_list *l); //nullptr ends capturing
+extern void msg_replay(const msg_list &l);
+
 typedef void (*msg_func)(const char *);
 typedef char (*msg_prompt_func)(const char *, const char *);
 
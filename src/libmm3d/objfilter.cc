@@ -72,11 +72,37 @@ public:
 	};
 	typedef std::vector<MaterialGroupT> MaterialGroupList;
 
+	//2024: readFile splits the file into line aligned chunks that are
+	//parsed on separate threads. Face indices are left as written and
+	//resolved as the chunks are added to the model in order.
+	struct ChunkT
+	{
+		const char *begin,*end;
+
+		std::vector<double> xyz;
+		UvDataList uv;
+
+		
+		struct FaceT
+		{
+			unsigned n,v,vt; //v/vt are how many came before the face.
+		};
+		std::vector<FaceT> faces;
+		std::vector<int> fv; //v,vt pairs (vt is 0 if missing.)
+
+		struct LineT
+		{
+			size_t face; const char *begin,*end;
+		};
+		std::vector<LineT> lines; //g, mtllib, usemtl
+		std::vector<LineT> badUvs;
+	};
+
 protected:
 	bool readLine(char *line);
-	bool readVertex(char *line);
-	bool readTextureCoord(char *line);
-	bool readFace(char *line);
+	void readChunk(ChunkT &c, unsigned vertex0, unsigned uv0);
+	void addFace(unsigned n, const unsigned *v, const int *vt);
+	void addVertices();
 	bool readGroup(char *line);
 	bool readLibrary(char *line);
 	bool readMaterial(char *line);
@@ -88,6 +114,8 @@ protected:
 
 	bool writeLine(const char *line,...);
 	bool writeStripped(const char *line,...);
+	void writeStripped(const char *tag, const double *v, int n, int places);
+	void writeFace(int tri);
 	bool writeHeader();
 	bool writeMaterials();
 	bool writeGroups();
@@ -105,6 +133,17 @@ protected:
 	UvDataList	 m_uvList;
 	MaterialGroupList m_mgList;
 
+	//2024: Triangles are added all at once after reading. m_st is
+	//6 per triangle and m_triGroup is the group for each triangle.
+	std::vector<double> m_xyz;
+	std::vector<unsigned> m_tris;
+	std::vector<float> m_st;
+	std::vector<int> m_triGroup;
+	bool m_textured;
+
+	//2024: The "vt" and "vn" number for each triangle vertex.
+	std::vector<unsigned> m_vtIndex,m_vnIndex;
+
 	std::string  m_groupName;
 
 	std::string  m_modelPath;
@@ -122,6 +161,7 @@ protected:
 #include "misc.h"
 #include "filtermgr.h"
 #include "mm3dport.h"
+#include "parallel.h"
 
 static void objfilter_replace(char *str,char this_char,char that_char)
 {
@@ -131,6 +171,35 @@ static void objfilter_replace(char *str,char this_char,char that_char)
 	}
 }
 
+//2024: Hash key for sharing "vt" and "vn" lines (see writeGroups.)
+//If scale is nonzero the values are rounded to that many places.
+struct objfilter_key
+{
+	uint64_t k[3];
+
+	objfilter_key(const double *v, int n, double scale)
+	{
+		for(int i=0;i<3;i++)
+		{
+			double d = i>=n?0:scale?std::nearbyint(v[i]*scale)+0.0:v[i];
+			memcpy(k+i,&d,sizeof(d));
+		}
+	}
+	bool operator==(const objfilter_key &o)const
+	{
+		return k[0]==o.k[0]&&k[1]==o.k[1]&&k[2]==o.k[2];
+	}
+	struct hash
+	{
+		size_t operator()(const objfilter_key &o)const
+		{
+			uint64_t h = 0;
+			for(auto ea:o.k) h = (h^ea)*0x9e3779b97f4a7c15ull;
+			return size_t(h^h>>29);
+		}
+	};
+};
+
 ObjFilter::ObjMaterial::ObjMaterial()
 	: name(""),
 	  shininess(0.0f),
@@ -148,6 +217,165 @@ ObjFilter::ObjMaterial::ObjMaterial()
 	specular[3] = 1.0f;
 }
 
+//2024: These replace sscanf("%d") and sscanf("%f") for reading 
+//large files. They stop at e since the file may be memory mapped.
+static bool objfilter_space(char c) //isspace (C locale)
+{
+	return c==' '||(unsigned)(c-'\t')<5;
+}
+static const char *objfilter_int(const char *p, const char *e, int &i)
+{
+	while(p<e&&objfilter_space(*p)) p++;
+
+	bool neg = false;
+	if(p<e&&(*p=='-'||*p=='+')) neg = *p++=='-';
+
+	const char *d = p; unsigned u = 0;
+	for(;p<e&&(unsigned)(*p-'0')<10;p++) u = u*10+(*p-'0');
+
+	i = neg?-(int)u:(int)u; return p==d?nullptr:p;
+}
+static const char *objfilter_float(const char *p, const char *e, float &f)
+{
+	static const double pow10[23] = 
+	{
+		1e0,1e1,1e2,1e3,1e4,1e5,1e6,1e7,1e8,1e9,1e10,1e11,
+		1e12,1e13,1e14,1e15,1e16,1e17,1e18,1e19,1e20,1e21,1e22
+	};
+
+	while(p<e&&objfilter_space(*p)) p++;
+
+	const char *s = p;
+
+	bool neg = false;
+	if(p<e&&(*p=='-'||*p=='+')) neg = *p++=='-';
+
+	//NOTE: ',' is accepted as a decimal point like before (it had
+	//replaced ',' with '.' on "v" and "vt" lines.)
+	uint64_t m = 0; int digits = 0, exp = 0; bool any = false;
+	for(;p<e&&(unsigned)(*p-'0')<10;p++,any=true)
+	{
+		if(digits<19){ m = m*10+(*p-'0'); if(m) digits++; }
+		else exp++;
+	}
+	if(p<e&&(*p=='.'||*p==','))
+	for(p++;p<e&&(unsigned)(*p-'0')<10;p++,any=true)
+	{
+		if(digits<19){ m = m*10+(*p-'0'); if(m) digits++; exp--; }
+	}
+	bool slow = digits>=19;
+	if(!any) 
+	{
+		//inf, nan, etc.
+		if(p<e&&((*p|32)=='i'||(*p|32)=='n')) slow = true;
+		else return nullptr;
+	}
+	else if(p<e&&(*p|32)=='x') slow = true; //Hex?
+	else if(p<e&&(*p|32)=='e')
+	{
+		const char *q = p+1; int x;
+		if(q<e&&*q!=' '&&(q=objfilter_int(q,e,x)))
+		{
+			p = q; exp+=std::max(-1000,std::min(1000,x));
+		}
+	}
+	if(!slow)
+	{
+		if(!m){ f = neg?-0.0f:0.0f; return p; }
+
+		//Exact in double, so only one rounding happens going to float
+		//unless the double is halfway between two floats.
+		if(m<=(1ull<<53)&&exp>=-22&&exp<=22)
+		{
+			double d = (double)m;
+			d = exp<0?d/pow10[-exp]:d*pow10[exp];
+			uint64_t bits; memcpy(&bits,&d,sizeof(bits));
+			if((bits&0x1fffffff)!=0x10000000)
+			{
+				f = (float)(neg?-d:d); return p;
+			}
+		}
+	}
+	char buf[64], *ep; size_t i;
+	for(i=0;s+i<e&&i<63&&!objfilter_space(s[i]);i++)
+	{
+		buf[i] = s[i]==','?'.':s[i];
+	}
+	buf[i] = '\0'; f = strtof(buf,&ep); return ep==buf?nullptr:s+(ep-buf);
+}
+static void objfilter_parse(ObjFilter::ChunkT &c)
+{
+	//NOTE: "vn" lines are skipped since MM3D calculates its normals
+	//from the groups' smoothing settings.
+	for(const char *p=c.begin,*e=c.end,*eol;p<e;p=eol+1)
+	{
+		eol = (const char*)memchr(p,'\n',e-p); if(!eol) eol = e;
+
+		const char *s = p;
+		while(s<eol&&objfilter_space(*s)) s++;
+		if(eol-s<2) continue;
+
+		auto is = [&](const char *tag, size_t n)
+		{
+			return (size_t)(eol-s)>=n&&!memcmp(s,tag,n);
+		};
+		if(is("v ",2))
+		{
+			float x,y,z; const char *q = s+2;
+			if((q=objfilter_float(q,eol,x))
+			&&(q=objfilter_float(q,eol,y))
+			&&(q=objfilter_float(q,eol,z)))
+			{
+				c.xyz.push_back(x);
+				c.xyz.push_back(y);
+				c.xyz.push_back(z);
+			}
+		}
+		else if(is("vt ",3))
+		{
+			ObjFilter::UvDataT uvd = {};
+			const char *q = objfilter_float(s+3,eol,uvd.u);
+			if(!q||!objfilter_float(q,eol,uvd.v))
+			{
+				c.badUvs.push_back({c.faces.size(),s+3,eol});
+			}
+			c.uv.push_back(uvd);
+		}
+		else if(is("f ",2))
+		{
+			ObjFilter::ChunkT::FaceT f = {0,(unsigned)c.xyz.size()/3,(unsigned)c.uv.size()};
+
+			int v; for(const char *q=s+2;(q=objfilter_int(q,eol,v));f.n++)
+			{
+				int vt = 0;
+
+				// Face has texture coords or normals
+				if(q<eol&&*q=='/')
+				{
+					if(++q<eol&&*q!='/')
+					{
+						if(!objfilter_space(*q)) objfilter_int(q,eol,vt);
+
+						while(q<eol&&*q!='/'&&!objfilter_space(*q))
+						q++;
+					}
+					if(q<eol&&*q=='/') // Skip normal index
+					{
+						while(q<eol&&!objfilter_space(*q))
+						q++;
+					}
+				}
+				c.fv.push_back(v); c.fv.push_back(vt);
+			}
+			c.faces.push_back(f);
+		}
+		else if(is("g ",2)||is("mtllib",6)||is("usemtl",6))
+		{
+			c.lines.push_back({c.faces.size(),s,eol});
+		}
+	}
+}
+
 Model::ModelErrorE ObjFilter::readFile(Model *model, const char *const filename)
 {
 	Model::ModelErrorE err = Model::ERROR_NONE;
@@ -174,15 +402,74 @@ Model::ModelErrorE ObjFilter::readFile(Model *model, const char *const filename)
 	m_curGroup  = -1;
 	m_curMaterial = -1;
 	m_needGroup = false;
+	m_textured = false;
 	m_uvList.clear();
 	m_mgList.clear();
+	m_xyz.clear();
+
+	//2024: MmapDataSource can hand over the whole file. Otherwise
+	//it's copied into memory.
+	size_t size = m_src->getRemaining();
+	std::vector<char> copy;
+	auto *data = (const char*)m_src->readDirect(size);
+	if(!data)
+	{
+		copy.resize(size);
+		if(size&&!m_src->readBytes(copy.data(),size))
+		return Model::ERROR_FILE_READ;
+		data = copy.data();
+	}
 
-	char line[1024];
-	while(m_src->readLine(line,sizeof(line)))
+	//Chunks are at least 1MB so small files aren't divided.
+	size_t n = std::min<size_t>(parallel_threads()*4,size>>20);
+	std::vector<ChunkT> chunks(std::max<size_t>(n,1));
+	n = chunks.size();
+	const char *p = data, *e = data+size;
+	for(size_t i=0;i<n;i++)
+	{
+		auto &c = chunks[i];
+		c.begin = p;
+		if(i+1<n)
+		{
+			p = std::max(p,data+size/n*(i+1));
+			auto *nl = p<e?(const char*)memchr(p,'\n',e-p):nullptr;
+			p = nl?nl+1:e;
+		}
+		else p = e; c.end = p;
+	}
+	parallel_for(n,1,[&](size_t i, size_t j)
+	{
+		for(;i<j;i++) objfilter_parse(chunks[i]);
+	});
+
+	//Vertices have to come first since the faces are checked against
+	//the final number of vertices.
+	std::vector<unsigned> vbase(n);
+	std::vector<unsigned> uvbase(n);
+	for(size_t i=0;i<n;i++)
+	{
+		vbase[i] = m_model->getVertexCount();
+		uvbase[i] = (unsigned)m_uvList.size();
+
+		auto &c = chunks[i];
+		m_xyz.swap(c.xyz); addVertices();
+		m_uvList.insert(m_uvList.end(),c.uv.begin(),c.uv.end());
+		c.uv.clear();
+		c.uv.shrink_to_fit();
+	}
+	m_vertices = m_model->getVertexCount();
+	for(size_t i=0;i<n;i++)
+	{
+		readChunk(chunks[i],vbase[i],uvbase[i]);
+		chunks[i] = ChunkT();
+	}
+
+	int tri = m_model->addTriangles(m_tris.size()/3,m_tris.data(),m_textured?m_st.data():nullptr);
+	for(int g:m_triGroup)
 	{
-		line[sizeof(line)-1] = '\0';
-		readLine(line);
+		if(g>=0) m_model->addTriangleToGroup(g,tri); tri++;
 	}
+	m_tris.clear(); m_st.clear(); m_triGroup.clear();
 
 	//log_debug("read %d vertices,%d faces,%d groups\n",m_vertices,m_faces,m_groups);
 
@@ -364,6 +651,25 @@ bool ObjFilter::writeStripped(const char *fmt,...)
 
 	return true;
 }
+void ObjFilter::writeStripped(const char *tag, const double *v, int n, int places)
+{
+	//2024: Same as writeStripped but without printf.
+	m_dst->text(tag);
+	for(int i=0;i<n;i++) m_dst->text(' ').text(v[i],places,true);
+	m_dst->textLine();
+}
+void ObjFilter::writeFace(int tri)
+{
+	m_dst->text('f');
+	for(int i=0;i<3;i++)
+	{
+		m_dst->text(' ').text(m_model->getTriangleVertex(tri,i)+1);
+		m_dst->text('/').text(m_vtIndex[tri*3+i]+1);
+		if(m_options->m_saveNormals)
+		m_dst->text('/').text(m_vnIndex[tri*3+i]+1);
+	}
+	m_dst->textLine();
+}
 
 bool ObjFilter::writeHeader()
 {
@@ -493,23 +799,13 @@ bool ObjFilter::writeGroups()
 
 	unsigned v = 0;
 	unsigned vcount = m_model->getVertexCount();
-	unsigned t = 0;
 	unsigned tcount = m_model->getTriangleCount();
 	unsigned g = 0;
 	unsigned gcount = m_model->getGroupCount();
 
-	char vertfmt[20];
-	char texfmt[20];
-	char normfmt[20];
-
-	sprintf(vertfmt,"v %%.%df %%.%df %%.%df",
-			m_options->m_places,m_options->m_places,m_options->m_places);
-
-	sprintf(texfmt,"vt %%.%df %%.%df",
-			m_options->m_texPlaces,m_options->m_texPlaces);
-
-	sprintf(normfmt,"vn %%.%df %%.%df %%.%df",
-			m_options->m_normalPlaces,m_options->m_normalPlaces,m_options->m_normalPlaces);
+	int places = m_options->m_places;
+	int texPlaces = m_options->m_texPlaces;
+	int normalPlaces = m_options->m_normalPlaces;
 
 	writeLine("# %d Vertices",vcount);
 
@@ -517,39 +813,71 @@ bool ObjFilter::writeGroups()
 	{
 		double coords[3];
 		m_model->getVertexCoords(v,coords);
-		writeStripped(vertfmt,coords[0],coords[1],coords[2]);
+		writeStripped("v",coords,3,places);
 	}
 	writeLine("");
 
-	writeLine("# %d Texture Coordinates",tcount *3);
+	//2024: Identical values are written once if m_shareCoords is set.
+	//The table is open addressed, holding 1 plus the index into keys.
+	std::vector<double> values;
+	std::vector<objfilter_key> keys;
+	std::vector<unsigned> table;
+	auto unique = [&](std::vector<unsigned> &index, int n, int places, auto get)
+	{
+		bool share = m_options->m_shareCoords;
+		double scale = m_options->m_quantize?pow(10.0,places):0;
+
+		size_t mask = 1;
+		while(mask<tcount*6) mask<<=1;
+		if(share) table.assign(mask--,0);
+
+		values.clear(); keys.clear();
+		index.resize(tcount*3);
+		for(unsigned i=0;i<tcount*3;i++)
+		{
+			double v[3]; get(i/3,i%3,v);
+
+			unsigned j = (unsigned)values.size()/n;
+			if(share)
+			{
+				objfilter_key key(v,n,scale);
+				size_t h = objfilter_key::hash()(key)&mask;
+				while(table[h]&&!(keys[table[h]-1]==key))
+				{
+					h = (h+1)&mask;
+				}
+				if(table[h])
+				{
+					index[i] = table[h]-1; continue;
+				}
+				table[h] = j+1; keys.push_back(key);
+			}
+			values.insert(values.end(),v,v+n); index[i] = j;
+		}
+	};
 
-	for(t = 0; t<tcount; t++)
+	unique(m_vtIndex,2,texPlaces,[&](int t, int i, double *uv)
 	{
 		float u,v;
-
-		m_model->getTextureCoords(t,0,u,v);
-		writeStripped(texfmt,u,v);
-		m_model->getTextureCoords(t,1,u,v);
-		writeStripped(texfmt,u,v);
-		m_model->getTextureCoords(t,2,u,v);
-		writeStripped(texfmt,u,v);
+		m_model->getTextureCoords(t,i,u,v); uv[0] = u; uv[1] = v;
+	});
+	writeLine("# %d Texture Coordinates",(int)(values.size()/2));
+	for(size_t i=0;i<values.size();i+=2)
+	{
+		writeStripped("vt",&values[i],2,texPlaces);
 	}
 	writeLine("");
 
 	if(m_options->m_saveNormals)
 	{
-		writeLine("# %d Vertex Normals",tcount *3);
-
-		for(t = 0; t<tcount; t++)
+		unique(m_vnIndex,3,normalPlaces,[&](int t, int i, double *norm)
+		{
+			m_model->getNormal(t,i,norm);
+		});
+		writeLine("# %d Vertex Normals",(int)(values.size()/3));
+		for(size_t i=0;i<values.size();i+=3)
 		{
-			double norm[3];
-
-			m_model->getNormal(t,0,norm);
-			writeStripped(normfmt,norm[0],norm[1],norm[2]);
-			m_model->getNormal(t,1,norm);
-			writeStripped(normfmt,norm[0],norm[1],norm[2]);
-			m_model->getNormal(t,2,norm);
-			writeStripped(normfmt,norm[0],norm[1],norm[2]);
+			writeStripped("vn",&values[i],3,normalPlaces);
 		}
 		writeLine("");
 	}
@@ -565,28 +893,7 @@ bool ObjFilter::writeGroups()
 		writeLine("g ungrouped");
 		writeLine("");
 
-		if(m_options->m_saveNormals)
-		{
-			int_list::iterator it;
-			for(it = tris.begin(); it!=tris.end(); it++)
-			{
-				writeLine("f %d/%d/%d %d/%d/%d %d/%d/%d",
-						m_model->getTriangleVertex(*it,0)+1,(*it)*3+1,(*it)*3+1,
-						m_model->getTriangleVertex(*it,1)+1,(*it)*3+2,(*it)*3+2,
-						m_model->getTriangleVertex(*it,2)+1,(*it)*3+3,(*it)*3+3);
-			}
-		}
-		else
-		{
-			int_list::iterator it;
-			for(it = tris.begin(); it!=tris.end(); it++)
-			{
-				writeLine("f %d/%d %d/%d %d/%d",
-						m_model->getTriangleVertex(*it,0)+1,(*it)*3+1,
-						m_model->getTriangleVertex(*it,1)+1,(*it)*3+2,
-						m_model->getTriangleVertex(*it,2)+1,(*it)*3+3);
-			}
-		}
+		for(int tri:tris) writeFace(tri);
 	}
 
 	std::string _str;
@@ -624,31 +931,12 @@ bool ObjFilter::writeGroups()
 
 			//free(grpStr);
 
-			if(m_options->m_saveNormals)
-			{
-				int_list::iterator it;
-				for(it = tris.begin(); it!=tris.end(); it++)
-				{
-					writeLine("f %d/%d/%d %d/%d/%d %d/%d/%d",
-							m_model->getTriangleVertex(*it,0)+1,(*it)*3+1,(*it)*3+1,
-							m_model->getTriangleVertex(*it,1)+1,(*it)*3+2,(*it)*3+2,
-							m_model->getTriangleVertex(*it,2)+1,(*it)*3+3,(*it)*3+3);
-				}
-			}
-			else
-			{
-				int_list::iterator it;
-				for(it = tris.begin(); it!=tris.end(); it++)
-				{
-					writeLine("f %d/%d %d/%d %d/%d",
-							m_model->getTriangleVertex(*it,0)+1,(*it)*3+1,
-							m_model->getTriangleVertex(*it,1)+1,(*it)*3+2,
-							m_model->getTriangleVertex(*it,2)+1,(*it)*3+3);
-				}
-			}
+			for(int tri:tris) writeFace(tri);
 		}
 	}
 
+	m_vtIndex.clear(); m_vnIndex.clear();
+
 	return true;
 }
 
@@ -696,23 +984,8 @@ bool ObjFilter::readLine(char *line)
 {
 	char *str = skipSpace(line);
 
-	if(strncmp(str,"v ",2)==0)
-	{
-		m_vertices++;
-		objfilter_replace(str,',','.');
-		readVertex(str);
-	}
-	else if(strncmp(str,"vt ",3)==0)
-	{
-		objfilter_replace(str,',','.');
-		readTextureCoord(str);
-	}
-	else if(strncmp(str,"f ",2)==0)
-	{
-		m_faces++;
-		readFace(str);
-	}
-	else if(strncmp(str,"g ",2)==0)
+	//2024: "v", "vt", and "f" lines are read by objfilter_parse.
+	if(strncmp(str,"g ",2)==0)
 	{
 		m_groups++;
 		readGroup(str);
@@ -728,114 +1001,70 @@ bool ObjFilter::readLine(char *line)
 	return true;
 }
 
-bool ObjFilter::readVertex(char *line)
+void ObjFilter::addVertices()
 {
-	line += 2;
-	float x,y,z;
-	if(sscanf(line,"%f %f %f",&x,&y,&z)==3)
-	{
-		m_model->addVertex(x,y,z);
-		return true;
-	}
-	return false;
+	m_model->addVertices(m_xyz.size()/3,m_xyz.data());
+	m_xyz.clear();
 }
 
-bool ObjFilter::readTextureCoord(char *line)
+void ObjFilter::readChunk(ChunkT &c, unsigned vertex0, unsigned uv0)
 {
-	line += 3;
-	UvDataT uvd;
-	uvd.u = 0.0f;
-	uvd.v = 0.0f;
-
-	if(sscanf(line,"%f %f",&uvd.u,&uvd.v)!=2)
+	for(auto&ea:c.badUvs)
 	{
-		log_warning("could not read 2 texture coordinates from %s\n",line);
+		std::string line(ea.begin,ea.end);
+		log_warning("could not read 2 texture coordinates from %s\n",line.c_str());
 	}
 
-	m_uvList.push_back(uvd);
-
-	return true;
-}
-
-bool ObjFilter::readFace(char *line)
-{
-	line += 2;
-	int_list vlist;
-	int_list vtlist;
-	int len = 0;
-	int v = 0;
+	std::vector<unsigned> vlist;
+	std::vector<int> vtlist;
 
-	while(sscanf(line,"%d%n",&v,&len)>0)
+	auto lt = c.lines.begin(), ld = c.lines.end();
+	auto *fv = c.fv.data();
+	size_t i = 0, n = c.faces.size();
+	for(;;i++)
 	{
-		if(v<0)
-		{
-			v = (int)m_model->getVertexCount()+v;
-		}
-		else
+		for(;lt<ld&&lt->face==i;lt++)
 		{
-			v = v-1;
+			char line[1024];
+			size_t len = std::min<size_t>(lt->end-lt->begin,sizeof(line)-1);
+			memcpy(line,lt->begin,len); line[len] = '\0';
+			readLine(line);
 		}
+		if(i==n) break;
 
-		int texidx  = -1;
-		int normidx = -1;
-
-		vlist.push_back(v);
+		auto &f = c.faces[i]; m_faces++;
 
-		line = &line[len];
-
-		// Face has texture coords or normals
-		if(line[0]=='/')
+		vlist.resize(f.n); vtlist.resize(f.n);
+		
+		bool addTextureCoords = true;
+		for(unsigned j=0;j<f.n;j++,fv+=2)
 		{
-			line++;
+			int v = fv[0], vt = fv[1];
 
-			if(line[0]!='/')
-			{
-				// Read texture coord index
-				texidx = atoi(line);
-				if(texidx<0)
-				{
-					texidx = m_uvList.size()+texidx;
-				}
-				else
-				{
-					texidx = texidx-1;
-				}
-				vtlist.push_back(texidx);
+			vlist[j] = v<0?vertex0+f.v+v:v-1;
 
-				while(line[0]!='\0'&&line[0]!='/'&&!isspace(line[0]))
-				{
-					line++;
-				}
-			}
+			if(vt<0) vt = uv0+f.vt+vt; else vt--;
 
-			if(line[0]=='/')
+			if(vt<0||vt>=(int)m_uvList.size())
 			{
-				line++;
-				// Read normal index (and ignore it)
-				// NOTE adjust for negative indices
-				normidx = atoi(line)-1;
-
-				while(line[0]!='\0'&&line[0]!=' ')
-				{
-					line++;
-				}
+				addTextureCoords = false; //Missing or invalid.
 			}
+			vtlist[j] = vt;
 		}
-
-		line = skipSpace(line);
+		addFace(f.n,vlist.data(),addTextureCoords?vtlist.data():nullptr);
 	}
+}
 
-	if(vlist.size()<3)
+void ObjFilter::addFace(unsigned n, const unsigned *vlist, const int *vtlist)
+{
+	if(n<3)
 	{
 		log_warning("face with less than 3 vertices\n");
-		return false;
+		return;
 	}
 
-	bool addTextureCoords = vtlist.size()==vlist.size();
-	for(unsigned n=0;n+2<vlist.size();n++)
+	for(unsigned i=0;i+2<n;i++)
 	{
-		int tri = m_model->addTriangle(vlist[0],vlist[n+1],vlist[n+2]);
-
 		if(m_needGroup&&m_curMaterial>=0)
 		{
 			int count = m_mgList.size();
@@ -863,22 +1092,31 @@ bool ObjFilter::readFace(char *line)
 			m_needGroup = false;
 		}
 
-		if(m_curGroup>=0)
+		unsigned v[3] = {vlist[0],vlist[i+1],vlist[i+2]};
+		if(v[0]>=(unsigned)m_vertices
+		 ||v[1]>=(unsigned)m_vertices
+		 ||v[2]>=(unsigned)m_vertices) continue; //addTriangle failed.
+
+		m_tris.insert(m_tris.end(),v,v+3);
+
+		m_triGroup.push_back(m_curGroup);
+
+		if(vtlist)
 		{
-			m_model->addTriangleToGroup(m_curGroup,tri);
-		}
+			m_textured = true;
 
-		if(addTextureCoords)
+			for(int j:{0,1,2})
+			{
+				auto &uv = m_uvList[vtlist[j?i+j:0]];
+				m_st.push_back(uv.u); m_st.push_back(uv.v);
+			}
+		}
+		else //Model::Triangle::init
 		{
-			int i = vtlist[0];
-			int j = vtlist[n+1], k = vtlist[n+2]; 
-			float st[2][3] = 
-			{{m_uvList[i].u,m_uvList[j].u,m_uvList[k].u}
-			,{m_uvList[i].v,m_uvList[j].v,m_uvList[k].v}};
-			m_model->setTextureCoords(tri,st);
+			float st[6] = {0,1,0,0,1,0};
+			m_st.insert(m_st.end(),st,st+6);
 		}
 	}
-	return true;
 }
 
 bool ObjFilter::readGroup(char *line)
@@ -0,0 +1,141 @@
+/*  MM3D Misfit/Maverick Model 3D
+ *
+ * Copyright (c)2004-2007 Kevin Worcester
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place-Suite 330, Boston, MA 02111-1307,
+ * USA.
+ *
+ * See the COPYING file for full license text.
+ */
+
+#include "mm3dtypes.h" //PCH
+
+#include "parallel.h"
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+static unsigned parallel_threads_set = 0;
+
+unsigned parallel_threads()
+{
+	if(unsigned n=parallel_threads_set) return n;
+
+	unsigned n = std::thread::hardware_concurrency();
+
+	return n?std::min(n,64u):1;
+}
+void parallel_set_threads(unsigned n)
+{
+	parallel_threads_set = n;
+}
+
+static struct parallel_pool_t
+{
+	std::vector<std::thread> threads;
+
+	std::mutex dispatch,m;
+	std::condition_variable cv,done;
+
+	unsigned gen = 0, active = 0; bool quit = false;
+
+	//Current job. Workers see this only after gen changes.
+	const std::function<void(size_t,size_t)> *f;
+	size_t n,grain; std::atomic<size_t> next;
+
+	void run()
+	{
+		for(;;)
+		{
+			size_t b = next.fetch_add(grain);
+			if(b>=n) break;
+			(*f)(b,std::min(b+grain,n));
+		}
+	}
+	void start(unsigned nt)
+	{
+		while(threads.size()<nt)
+		threads.push_back(std::thread(&parallel_pool_t::worker,this,gen));
+	}
+	void worker(unsigned seen);
+
+	~parallel_pool_t()
+	{
+		{
+			std::lock_guard<std::mutex> lk(m);
+			quit = true;
+		}
+		cv.notify_all();
+		for(auto&ea:threads) ea.join();
+	}
+
+}parallel_pool;
+
+static thread_local bool parallel_worker = false;
+
+void parallel_pool_t::worker(unsigned seen)
+{
+	parallel_worker = true;
+
+	for(std::unique_lock<std::mutex> lk(m);;)
+	{
+		cv.wait(lk,[&]{ return quit||gen!=seen; });
+
+		if(quit) return;
+
+		seen = gen;
+
+		lk.unlock(); run(); lk.lock();
+
+		if(!--active) done.notify_one();
+	}
+}
+
+void parallel_for(size_t n, size_t grain, const std::function<void(size_t,size_t)> &f)
+{
+	if(!n) return;
+
+	unsigned nt = parallel_threads();
+
+	grain = std::max<size_t>(grain,1);
+
+	auto &p = parallel_pool;
+
+	if(nt<=1||n<=grain||parallel_worker||!p.dispatch.try_lock())
+	{
+		return f(0,n);
+	}
+	std::lock_guard<std::mutex> lk2(p.dispatch,std::adopt_lock);
+
+	//Aim for a few chunks per thread so uneven loads balance out.
+	grain = std::max(grain,n/(nt*4));
+	nt = (unsigned)std::min<size_t>(nt,(n+grain-1)/grain);
+
+	p.start(nt-1);
+
+	p.f = &f; p.n = n; p.grain = grain; p.next = 0;
+	{
+		std::lock_guard<std::mutex> lk(p.m);
+		p.active = (unsigned)p.threads.size(); p.gen++;
+	}
+	p.cv.notify_all();
+
+	parallel_worker = true; p.run(); parallel_worker = false;
+
+	std::unique_lock<std::mutex> lk(p.m);
+	p.done.wait(lk,[&]{ return !p.active; });
+}
@@ -0,0 +1,46 @@
+/*  MM3D Misfit/Maverick Model 3D
+ *
+ * Copyright (c)2004-2007 Kevin Worcester
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place-Suite 330, Boston, MA 02111-1307,
+ * USA.
+ *
+ * See the COPYING file for full license text.
+ */
+
+
+#ifndef __PARALLEL_H
+#define __PARALLEL_H
+
+#include <stddef.h>
+#include <functional>
+
+//2024: This is a small worker pool for splitting up loops over the
+//model's vertices/triangles. The workers are started on first use
+//and are shared by all models. Calls made from inside a worker, or
+//while another thread is dispatching, just run on the caller's own
+//thread, so it's always safe to call parallel_for.
+//
+// The callback receives a [begin,end) range. Ranges never overlap
+// so writing to elements in the range doesn't require any locking.
+//
+extern void parallel_for(size_t n, size_t grain, const std::function<void(size_t,size_t)>&);
+
+//Number of threads parallel_for divides work between (including the
+//calling thread.) 0 restores the default (the number of CPU cores.)
+extern unsigned parallel_threads();
+extern void parallel_set_threads(unsigned);
+
+#endif // __PARALLEL_H
@@ -68,14 +68,38 @@ public:
 protected:
 
 	Texture::ErrorE load_image(DataSource &src);
-	void load_1(DataSource &src, int width, int height, uint8_t *buffer, int bytes);
-	void load_4(DataSource &src, int width, int height, uint8_t *buffer, int bytes);
-	void load_8(DataSource &src, int width, int height, uint8_t *buffer, int bytes);
-	void load_24(DataSource &src, int width, int height, uint8_t *buffer, int bytes);
-	void readline(DataSource &src, uint8_t *buffer, int	 bytes);
+	void load_1(int width, int height, uint8_t *buffer, int bytes);
+	void load_4(int width, int height, uint8_t *buffer, int bytes);
+	void load_8(int width, int height, uint8_t *buffer, int bytes);
+	void load_24(int width, int height, uint8_t *buffer, int bytes);
+	void readline(uint8_t *buffer, int bytes);
 
 	uint8_t m_palette[256][3];
 	Texture *m_texture;
+
+	struct PcxHeader
+	{
+		uint8_t manufacturer;
+		uint8_t version;
+		uint8_t compression;
+		uint8_t bpp;
+		int16_t x1,y1;
+		int16_t x2,y2;
+		int16_t hdpi;
+		int16_t vdpi;
+		uint8_t colormap[48];
+		uint8_t reserved;
+		uint8_t planes;
+		int16_t bytesperline;
+		int16_t color;
+		uint8_t filler[58];
+	}pcx_header; //2024: This was a static global.
+
+	//2024: readline decodes from this span instead of reading
+	//every byte from the DataSource. RLE runs can span lines so
+	//the run state is kept here (it had been static.)
+	const uint8_t *m_p,*m_e;
+	int m_count; uint8_t m_value;
 };
 
 extern TextureFilter *pcxtex(){ return new PcxTextureFilter; }
@@ -88,24 +112,6 @@ Texture::ErrorE PcxTextureFilter::readData(Texture &texture, DataSource &src, co
 
 static uint8_t pcxtex_mono[6]= { 0,0,0,255,255,255 };
 
-static struct
-{
-	uint8_t manufacturer;
-	uint8_t version;
-	uint8_t compression;
-	uint8_t bpp;
-	int16_t x1,y1;
-	int16_t x2,y2;
-	int16_t hdpi;
-	int16_t vdpi;
-	uint8_t colormap[48];
-	uint8_t reserved;
-	uint8_t planes;
-	int16_t bytesperline;
-	int16_t color;
-	uint8_t filler[58];
-} pcx_header;
-
 Texture::ErrorE PcxTextureFilter::load_image(DataSource &src)
 {
 	int offset_x,offset_y;
@@ -150,33 +156,53 @@ Texture::ErrorE PcxTextureFilter::load_image(DataSource &src)
 	m_texture->m_data.resize(m_texture->m_width*m_texture->m_height*3);
 	uint8_t *data = m_texture->m_data.data();
 
+	if(pcx_header.planes==1&&pcx_header.bpp==8)
+	{
+		//2024: Reading this first so readDirect's span stays valid.
+		off_t pos = src.offset();
+		src.seek(src.getFileSize()-(256*3));
+		src.readBytes(&m_palette[0][0],(256*3));
+		src.seek(pos);
+		if(src.errorOccurred())
+		{
+			return errnoToTextureError(src.getErrno(),Texture::ERROR_FILE_READ);
+		}
+	}
+
+	//2024: Decode the rest of the input as one span, like objfilter.cc.
+	size_t size = src.getRemaining();
+	std::vector<uint8_t> copy;
+	m_p = src.readDirect(size);
+	if(!m_p)
+	{
+		copy.resize(size);
+		if(size&&!src.readBytes(copy.data(),size))
+		{
+			return errnoToTextureError(src.getErrno(),Texture::ERROR_FILE_READ);
+		}
+		m_p = copy.data();
+	}
+	m_e = m_p+size; m_count = 0; m_value = 0;
+
 	if(pcx_header.planes==1&&pcx_header.bpp==1)
 	{
 		memcpy(m_palette,pcxtex_mono,(2*3));
-		load_1 (src,m_texture->m_width,m_texture->m_height,data, (pcx_header.bytesperline));
+		load_1(m_texture->m_width,m_texture->m_height,data, (pcx_header.bytesperline));
 	}
 #if 0 //UNIMPLEMENTED
 	else if(pcx_header.planes==4&&pcx_header.bpp==1)
 	{
 		memcpy(m_palette,pcx_header.colormap,(16*3));
-		load_4(src,m_texture->m_width,m_texture->m_height,data, (pcx_header.bytesperline));
+		load_4(m_texture->m_width,m_texture->m_height,data, (pcx_header.bytesperline));
 	}
 #endif
 	else if(pcx_header.planes==1&&pcx_header.bpp==8)
 	{
-		off_t pos = src.offset();
-		src.seek(src.getFileSize()-(256*3));
-		src.readBytes(&m_palette[0][0],(256*3));
-		src.seek(pos);
-		if(src.errorOccurred())
-		{
-			return errnoToTextureError(src.getErrno(),Texture::ERROR_FILE_READ);
-		}
-		load_8(src,m_texture->m_width,m_texture->m_height,data, (pcx_header.bytesperline));
+		load_8(m_texture->m_width,m_texture->m_height,data, (pcx_header.bytesperline));
 	}
 	else if(pcx_header.planes==3&&pcx_header.bpp==8)
 	{
-		load_24(src,m_texture->m_width,m_texture->m_height,data, (pcx_header.bytesperline));
+		load_24(m_texture->m_width,m_texture->m_height,data, (pcx_header.bytesperline));
 	}
 	else
 	{
@@ -186,7 +212,7 @@ Texture::ErrorE PcxTextureFilter::load_image(DataSource &src)
 	return Texture::ERROR_NONE;
 }
 
-void PcxTextureFilter::load_8(DataSource &src, int m_width, int m_height, uint8_t *buffer, int	bytes)
+void PcxTextureFilter::load_8(int m_width, int m_height, uint8_t *buffer, int	bytes)
 {
 	int x,y;
 	uint8_t *line;
@@ -196,7 +222,7 @@ void PcxTextureFilter::load_8(DataSource &src, int m_width, int m_height, uint8_
 	for(y = m_height-1; y>=0; --y)
 	{
 		row = &buffer[y *(m_width*3)];
-		readline (src,line,bytes);
+		readline(line,bytes);
 		for(x = 0; x<m_width; ++x)
 		{
 			memcpy(&row[x*3],m_palette[line[x]],3);
@@ -206,7 +232,7 @@ void PcxTextureFilter::load_8(DataSource &src, int m_width, int m_height, uint8_
 	free (line);
 }
 
-void PcxTextureFilter::load_24(DataSource &src, int m_width, int m_height,uint8_t *buffer, int	bytes)
+void PcxTextureFilter::load_24(int m_width, int m_height,uint8_t *buffer, int	bytes)
 {
 	int x,y,c;
 	uint8_t *line;
@@ -216,20 +242,24 @@ void PcxTextureFilter::load_24(DataSource &src, int m_width, int m_height,uint8_
 	for(y = m_height-1; y>=0; --y)
 	{
 		row = &buffer[y *(m_width*3)];
+		//2024: Interleave the planes in one pass.
 		for(c = 0; c<3; ++c)
 		{
-			readline (src,line,bytes);
-			for(x = 0; x<m_width; ++x)
-			{
-				row[x *3+c] = line[x];
-			}
+			readline(line+c*bytes,bytes);
+		}
+		uint8_t *r = line, *g = r+bytes, *b = g+bytes;
+		for(x = 0; x<m_width; ++x)
+		{
+			row[x*3+0] = r[x];
+			row[x*3+1] = g[x];
+			row[x*3+2] = b[x];
 		}
 	}
 
 	free (line);
 }
 
-void PcxTextureFilter::load_1(DataSource &src, int m_width, int m_height, uint8_t *buffer, int	bytes)
+void PcxTextureFilter::load_1(int m_width, int m_height, uint8_t *buffer, int	bytes)
 {
 	int x,y;
 	uint8_t *line;
@@ -239,7 +269,7 @@ void PcxTextureFilter::load_1(DataSource &src, int m_width, int m_height, uint8_
 	for(y = m_height-1; y>=0; --y)
 	{
 		row = &buffer[y *(m_width*3)];
-		readline (src,line,bytes);
+		readline(line,bytes);
 		for(x = 0; x<m_width; ++x)
 		{
 			if(line[x/8] &(128>> (x%8)))
@@ -256,7 +286,7 @@ void PcxTextureFilter::load_1(DataSource &src, int m_width, int m_height, uint8_
 	free (line);
 }
 
-void PcxTextureFilter::load_4(DataSource &src, int	m_width, int m_height,uint8_t *buffer, int	bytes)
+void PcxTextureFilter::load_4(int	m_width, int m_height,uint8_t *buffer, int	bytes)
 {
 	// TODO implement this if I ever want it to work
 	/*
@@ -284,34 +314,42 @@ void PcxTextureFilter::load_4(DataSource &src, int	m_width, int m_height,uint8_t
 	*/
 }
 
-void PcxTextureFilter::readline(DataSource &src,uint8_t *buffer, int bytes)
+void PcxTextureFilter::readline(uint8_t *buffer, int bytes)
 {
-	static uint8_t count = 0,value = 0;
-
 	if(pcx_header.compression)
 	{
-		while(bytes--)
+		while(bytes>0)
 		{
-			if(count==0)
+			if(m_count==0)
 			{
-				src.read(value);
-				if(value<0xc0)
+				//2024: Past the end this fills with 0.
+				if(m_p==m_e)
+				{
+					memset(buffer,0,bytes); return;
+				}
+				m_value = *m_p++;
+				if(m_value<0xc0)
 				{
-					count = 1;
+					m_count = 1;
 				} 
 				else 
 				{
-					count = value-0xc0;
-					src.read(value);
+					//0xc0 is 256 since count was uint8_t.
+					m_count = m_value-0xc0;
+					if(!m_count) m_count = 256;
+					m_value = m_p<m_e?*m_p++:0;
 				}
 			}
-			count--;
-			*(buffer++)= value;
+			int n = std::min(m_count,bytes);
+			memset(buffer,m_value,n);
+			buffer+=n; bytes-=n; m_count-=n;
 		}
 	}
 	else
 	{
-		src.readBytes(buffer,bytes);
+		int n = (int)std::min<size_t>(bytes,m_e-m_p);
+		memcpy(buffer,m_p,n); m_p+=n;
+		memset(buffer+n,0,bytes-n);
 	}
 }
 
@@ -100,6 +100,12 @@ Model::ModelErrorE SmdFilter::readFile(Model *model, const char *const filename)
 	return Model::ERROR_UNSUPPORTED_OPERATION;
 }
 
+//2024: Same as " %.6f" without printf.
+template<class T>
+static DataDest &smdfilter_floats(DataDest &dst, int n, const T *f)
+{
+	for(int i=0;i<n;i++) dst.text(' ').text(f[i],6); return dst;
+}
 Model::ModelErrorE SmdFilter::writeFile(Model *model, const char *const filename, Options &o)
 {
 	m_options = o.getOptions<SmdOptions>();
@@ -201,8 +207,8 @@ Model::ModelErrorE SmdFilter::writeFile(Model *model, const char *const filename
 
 		if(defaultBoneJoint)
 		{
-			writeLine(dst,"%d %.6f %.6f %.6f %.6f %.6f %.6f",
-							0,0.0f,0.0f,0.0f,0.0f,0.0f,0.0f);
+			float zero[6] = {};
+			smdfilter_floats(dst->text(0),6,zero).textLine();
 		}
 		else for(unsigned bone = 0; bone<boneCount; bone++)
 		{
@@ -228,9 +234,9 @@ Model::ModelErrorE SmdFilter::writeFile(Model *model, const char *const filename
 			lm.getTranslation(trans);
 			lm.getRotation(rot);
 
-			writeLine(dst,"%d %.6f %.6f %.6f %.6f %.6f %.6f",bone,
-							(float)trans[0],(float)trans[1],(float)trans[2],
-							(float)rot[0],(float)rot[1],(float)rot[2]);
+			float v[6] = {(float)trans[0],(float)trans[1],(float)trans[2],
+				(float)rot[0],(float)rot[1],(float)rot[2]};
+			smdfilter_floats(dst->text((int)bone),6,v).textLine();
 		}
 
 		if(m_options->m_savePointsJoint)
@@ -259,9 +265,9 @@ Model::ModelErrorE SmdFilter::writeFile(Model *model, const char *const filename
 				lm.getTranslation(trans);
 				lm.getRotation(rot);
 
-				writeLine(dst,"%d %.6f %.6f %.6f %.6f %.6f %.6f",boneCount+point,
-								(float)trans[0],(float)trans[1],(float)trans[2],
-								(float)rot[0],(float)rot[1],(float)rot[2]);
+				float v[6] = {(float)trans[0],(float)trans[1],(float)trans[2],
+					(float)rot[0],(float)rot[1],(float)rot[2]};
+				smdfilter_floats(dst->text((int)(boneCount+point)),6,v).textLine();
 			}
 		}
 
@@ -312,8 +318,8 @@ Model::ModelErrorE SmdFilter::writeFile(Model *model, const char *const filename
 
 				if(defaultBoneJoint)
 				{
-					writeLine(dst,"%d %.6f %.6f %.6f %.6f %.6f %.6f",
-									0,0.0f,0.0f,0.0f,0.0f,0.0f,0.0f);
+					float zero[6] = {};
+					smdfilter_floats(dst->text(0),6,zero).textLine();
 				}
 				else
 				{
@@ -359,9 +365,9 @@ Model::ModelErrorE SmdFilter::writeFile(Model *model, const char *const filename
 						// keyframes for all frames.
 
 						// FIXME?: Printf %.6f can round "rot" to 0.000001 greater than M_PI.
-						writeLine(dst,"%d %.6f %.6f %.6f %.6f %.6f %.6f",bone,
-										(float)trans[0],(float)trans[1],(float)trans[2],
-										(float)rot[0],(float)rot[1],(float)rot[2]);
+						float v[6] = {(float)trans[0],(float)trans[1],(float)trans[2],
+							(float)rot[0],(float)rot[1],(float)rot[2]};
+						smdfilter_floats(dst->text((int)bone),6,v).textLine();
 					}
 				}
 
@@ -393,9 +399,9 @@ Model::ModelErrorE SmdFilter::writeFile(Model *model, const char *const filename
 						lm.getRotation(rot);
 
 						// FIXME?: Printf %.6f can round "rot" to 0.000001 greater than M_PI.
-						writeLine(dst,"%d %.6f %.6f %.6f %.6f %.6f %.6f",boneCount+point,
-										(float)trans[0],(float)trans[1],(float)trans[2],
-										(float)rot[0],(float)rot[1],(float)rot[2]);
+						float v[6] = {(float)trans[0],(float)trans[1],(float)trans[2],
+							(float)rot[0],(float)rot[1],(float)rot[2]};
+						smdfilter_floats(dst->text((int)(boneCount+point)),6,v).textLine();
 					}
 				}
 			}
@@ -446,7 +452,7 @@ Model::ModelErrorE SmdFilter::writeFile(Model *model, const char *const filename
 
 			for(fit = faces.begin(); fit!=faces.end(); fit++)
 			{
-				writeLine(dst,"%s",materialName.c_str());
+				dst->text(materialName.c_str()).textLine();
 
 				for(int vindex = 0; vindex<3; vindex++)
 				{
@@ -508,22 +514,22 @@ Model::ModelErrorE SmdFilter::writeFile(Model *model, const char *const filename
 						}
 					}
 
-					dst->writePrintf("%d %.6f %.6f %.6f %.6f %.6f %.6f %.6f %.6f",
-						vertBone,
-						(float)meshVec[0],(float)meshVec[1],(float)meshVec[2],
-						meshNor[0],meshNor[1],meshNor[2],
-						uv[0],uv[1]);
+					float xyz[3] = {(float)meshVec[0],(float)meshVec[1],(float)meshVec[2]};
+					smdfilter_floats(dst->text(vertBone),3,xyz);
+					smdfilter_floats(*dst,3,meshNor);
+					smdfilter_floats(*dst,2,uv);
 
 					if(m_options->m_multipleVertexInfluences)
 					{
-						dst->writePrintf(" %d",(int)influences.size());
+						dst->text(' ').text((int)influences.size());
 						for(it = influences.begin(); it!=influences.end(); it++)
 						{
-							dst->writePrintf(" %d %.6f",it->m_boneId,(float)it->m_weight);
+							dst->text(' ').text(it->m_boneId);
+							dst->text(' ').text((float)it->m_weight,6);
 						}
 					}
 
-					dst->writePrintf("\r\n");
+					dst->textLine();
 				}
 			}
 		}
@@ -124,7 +124,50 @@ public:
 	bool find_sorted(const T &val, unsigned &index)const;
 
 	static bool less(T a, T b){ return *a<*b; };
-	void sort(){ std::sort(begin(),end(),less); }
+	void sort(){ changes++; std::sort(begin(),end(),less); }
+
+	//2024: This counts edits to the vector so that lookup tables
+	//built on top of the list can tell if they're out-of-date. All
+	//of std::vector's modifiers are hidden here so that none skip
+	//it. (Assigning elements via [] or data() is not counted.)
+	unsigned changes = 0;
+
+	typedef typename std::vector<T>::iterator iterator;
+	iterator erase(iterator it)
+	{
+		changes++; return std::vector<T>::erase(it);
+	}
+	iterator erase(iterator a, iterator b)
+	{
+		changes++; return std::vector<T>::erase(a,b);
+	}
+	void clear(){ changes++; std::vector<T>::clear(); }
+	void push_back(const T &val){ changes++; std::vector<T>::push_back(val); }
+	void pop_back(){ changes++; std::vector<T>::pop_back(); }
+	template<class...A> void emplace_back(A&&...a)
+	{
+		changes++; std::vector<T>::emplace_back(std::forward<A>(a)...);
+	}
+	template<class...A> iterator insert(A&&...a)
+	{
+		changes++; return std::vector<T>::insert(std::forward<A>(a)...);
+	}
+	template<class...A> iterator emplace(A&&...a)
+	{
+		changes++; return std::vector<T>::emplace(std::forward<A>(a)...);
+	}
+	template<class...A> void resize(A&&...a)
+	{
+		changes++; std::vector<T>::resize(std::forward<A>(a)...);
+	}
+	template<class...A> void assign(A&&...a)
+	{
+		changes++; std::vector<T>::assign(std::forward<A>(a)...);
+	}
+	void swap(sorted_ptr_list &cp)
+	{
+		changes++; cp.changes++; std::vector<T>::swap(cp);
+	}
 };
  
 template<typename T> 
@@ -30,15 +30,26 @@
 #include "translate.h"
 #include "filedatadest.h" //NEW
 #include "filedatasource.h" //NEW
+#include "mmapdatasource.h"
 
 #include "modelstatus.h"
 
+#include <mutex>
+
 typedef const char *utf8; //REMOVE ME
 
 static bool txmgr_doWarning = false;
 
+//2024: Models may be loaded on more than one thread (cmdline.cc's
+//--jobs option.) Texture filters aren't reentrant, so this guards
+//everything that reads/writes textures or touches m_textures.
+static std::recursive_mutex txmgr_mutex;
+#define TXMGR_LOCK std::lock_guard<std::recursive_mutex> lk(txmgr_mutex)
+
 void texture_manager_do_warning(Model *model) 
 {
+	TXMGR_LOCK;
+
 	if(!txmgr_doWarning) return; txmgr_doWarning = false;
 
 	const char *msg =  
@@ -98,6 +109,8 @@ void TextureManager::registerTextureFilter(TextureFilter *filter)
 
 Texture *TextureManager::getTexture(const char *filename, bool noCache, bool warning)
 {
+	TXMGR_LOCK;
+
 	if(!filename) return nullptr; //???
 
 	if(!noCache)	
@@ -113,17 +126,30 @@ Texture *TextureManager::getTexture(const char *filename, bool noCache, bool war
 		return getBlankTexture("blank");
 	}
 
-	FileDataSource lvalue(filename);
-	Texture *ret = getTexture(filename,lvalue,warning);
+	//2024: Map the file if possible (see FileFactory::createSource.)
+	Texture *ret;
+	MmapDataSource mm(filename);
+	if(!mm.errorOccurred())
+	{
+		ret = getTexture(filename,mm,warning);
+	}
+	else
+	{
+		FileDataSource lvalue(filename);
+		ret = getTexture(filename,lvalue,warning);
+	}
 
 	if(noCache&&ret) m_textures.pop_back(); return ret; //HACK
 }
 Texture *TextureManager::getTexture(const char *name_and_format, DataSource &src, bool warning)
 {
+	TXMGR_LOCK;
+
 	if(!name_and_format) return nullptr;
 	Texture *newTexture = new Texture();
 
 	void *is_file = dynamic_cast<FileDataSource*>(&src); //HACK
+	if(!is_file) is_file = dynamic_cast<MmapDataSource*>(&src);
 	if(is_file) newTexture->m_filename = name_and_format;
 
 	const char *name = strrchr(name_and_format,'/');
@@ -185,6 +211,8 @@ Texture *TextureManager::getTexture(const char *name_and_format, DataSource &src
 
 bool TextureManager::reloadTextures()
 {
+	TXMGR_LOCK;
+
 	bool anyTextureChanged = false;
 	
 	//TODO: Make getTexture not push/pop m_textures.
@@ -225,6 +253,8 @@ bool TextureManager::reloadTextures()
 
 Texture *TextureManager::getBlankTexture(const char *name)
 {
+	TXMGR_LOCK;
+
 	for(auto*ea:m_textures)
 	{
 		//2019: Assuming this is erroneous.
@@ -258,6 +288,8 @@ Texture *TextureManager::getBlankTexture(const char *name)
 
 Texture *TextureManager::getDefaultTexture(const char *filename)
 {
+	TXMGR_LOCK;
+
 	Texture *tex = new Texture();
 	tex->m_isBad = true;
 	
@@ -305,6 +337,8 @@ Texture::ErrorE TextureManager::write(Texture *tex, utf8 filename)
 }
 Texture::ErrorE TextureManager::write(Texture *tex, DataDest &dest, utf8 format)
 {
+	TXMGR_LOCK;
+
 	if(!tex) return Texture::ERROR_BAD_ARGUMENT;
 
 	if(format&&*format)
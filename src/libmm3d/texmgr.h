@@ -142,7 +142,7 @@ public:
 	
 	//UNUSED
 	//NOTE: This is changed to not set the texture's filename unless 
-	//nullptr!=dynamic_cast<FileDataSource*>(&data).	
+	//nullptr!=dynamic_cast<FileDataSource*>(&data). (Or MmapDataSource.)
 	Texture *getTexture(const char *name_and_format, DataSource &ds, bool warn=true);
 	Texture *getTexture(const char *filename, bool noCache=false, bool warning=true);
 	Texture *getBlankTexture(const char *filename);
@@ -25,7 +25,7 @@
 #include "texture.h"
 #include "translate.h"
 
-int Texture::s_allocated = 0;
+std::atomic<int> Texture::s_allocated(0);
 
 Texture::Texture()
 	:
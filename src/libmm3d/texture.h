@@ -87,7 +87,7 @@ class Texture
 
 		time_t	 m_loadTime;
 
-		static int s_allocated;
+		static std::atomic<int> s_allocated;
 };
 
 //errorobj.cc
@@ -27,6 +27,20 @@
 #include "texmgr.h"
 #include "filedatasource.h"
 
+#if defined(__GNUC__)&&(defined(__x86_64__)||defined(__i386__))
+#include <immintrin.h>
+#define TGATEX_SSSE3 __attribute__((target("ssse3")))
+static bool tgatex_has_ssse3(){ return __builtin_cpu_supports("ssse3"); }
+#elif defined(_MSC_VER)&&defined(_M_X64)
+#include <immintrin.h>
+#include <intrin.h>
+#define TGATEX_SSSE3
+static bool tgatex_has_ssse3()
+{
+	int r[4]; __cpuid(r,1); return (r[2]&0x200)!=0; //SSSE3
+}
+#endif
+
 struct TGAHeaderT
 {
 	uint8_t Header[12];
@@ -40,8 +54,9 @@ struct TGA
 	uint8_t reserved;
 };
 
-static TGAHeaderT tgaheader;
-static TGA tga;
+//2024: These were static (tgaheader and tga) which isn't thread safe.
+//static TGAHeaderT tgaheader;
+//static TGA tga;
 
 static uint8_t uTGAcompare[12] = {0,0,2,0,0,0,0,0,0,0,0,0};	// Uncompressed TGA Header
 static uint8_t cTGAcompare[12] = {0,0,10,0,0,0,0,0,0,0,0,0};	// Compressed TGA Header
@@ -59,7 +74,62 @@ static Texture::ErrorE SourceGetError(DataSource &src)
 	return Texture::ERROR_NONE;
 }
 
-static Texture::ErrorE LoadUncompressedTGA(Texture &texture, DataSource &src)
+#ifdef TGATEX_SSSE3
+TGATEX_SSSE3 static size_t tgatex_swizzle_ssse3(uint8_t *dst, const uint8_t *src, size_t size, int bytespp)
+{
+	//16 bytes are loaded for 5 RGB pixels. The 16th byte is stored
+	//unchanged, and then overwritten by the next 5 pixels.
+	__m128i m = bytespp==4
+	?_mm_setr_epi8(2,1,0,3,6,5,4,7,10,9,8,11,14,13,12,15)
+	:_mm_setr_epi8(2,1,0,5,4,3,8,7,6,11,10,9,14,13,12,15);
+
+	size_t step = bytespp==4?16:15, i = 0;
+	for(;i+16<=size;i+=step)
+	{
+		__m128i x = _mm_loadu_si128((const __m128i*)(src+i));
+		_mm_storeu_si128((__m128i*)(dst+i),_mm_shuffle_epi8(x,m));
+	}
+	return i;
+}
+#endif
+//2024: Converts BGR(A) to RGB(A). dst may be src.
+static void tgatex_swizzle(uint8_t *dst, const uint8_t *src, size_t n, int bytespp)
+{
+	size_t i = 0, size = n*bytespp;
+
+	#ifdef TGATEX_SSSE3
+	static const bool ssse3 = tgatex_has_ssse3();
+	if(ssse3) i = tgatex_swizzle_ssse3(dst,src,size,bytespp);
+	#endif
+
+	for(;i<size;i+=bytespp)
+	{
+		uint8_t b = src[i+0];
+		dst[i+1] = src[i+1];
+		dst[i+0] = src[i+2];
+		dst[i+2] = b;
+		if(bytespp==4) dst[i+3] = src[i+3];
+	}
+}
+//2024: Fills n pixels with the (BGR(A)) pixel in src.
+static void tgatex_fill(uint8_t *dst, const uint8_t *src, size_t n, int bytespp)
+{
+	tgatex_swizzle(dst,src,1,bytespp);
+
+	if(src[0]==src[1]&&src[1]==src[2]&&(bytespp==3||src[2]==src[3]))
+	{
+		memset(dst,src[0],n*bytespp); return;
+	}
+
+	//Double the filled part until it's done.
+	size_t size = n*bytespp;
+	for(size_t i=bytespp;i<size;i*=2)
+	{
+		memcpy(dst+i,dst,std::min(i,size-i));
+	}
+}
+
+static Texture::ErrorE LoadUncompressedTGA(Texture &texture, DataSource &src, TGA &tga)
 {
 	//log_debug("loading uncompressed TGA\n");
 
@@ -97,22 +167,23 @@ static Texture::ErrorE LoadUncompressedTGA(Texture &texture, DataSource &src)
 
 	//log_debug("image size = %d\n",imageSize);
 
-	if(!src.readBytes(data,imageSize))
+	//2024: MmapDataSource can swizzle straight out of the file.
+	const uint8_t *p = src.readDirect(imageSize);
+	if(!p)
 	{
-		return SourceGetError(src);
+		if(!src.readBytes(data,imageSize))
+		{
+			return SourceGetError(src);
+		}
+		p = data;
 	}
 
-	for(uint32_t n = 0; n<imageSize; n += bytespp)
-	{
-		uint8_t temp = data[n+0];
-		data[n+0] = data[n+2];
-		data[n+2] = temp;
-	}
+	tgatex_swizzle(data,p,width*height,bytespp);
 
 	return Texture::ERROR_NONE;
 }
 
-static Texture::ErrorE LoadCompressedTGA(Texture &texture, DataSource &src)
+static Texture::ErrorE LoadCompressedTGA(Texture &texture, DataSource &src, TGA &tga)
 { 
 	//log_debug("loading compressed TGA\n");
 
@@ -149,58 +220,51 @@ static Texture::ErrorE LoadCompressedTGA(Texture &texture, DataSource &src)
 
 	uint32_t pixelcount = height *width;
 	uint32_t currentpixel = 0;
-	uint32_t currentbyte = 0;
-	uint8_t colorbuffer[4];
 
 	texture.m_format = hasAlpha ? Texture::FORMAT_RGBA : Texture::FORMAT_RGB;
 
-	do
+	//2024: This had read each pixel from src. Instead decode the
+	//rest of the input as one span, like objfilter.cc.
+	size_t size = src.getRemaining();
+	std::vector<uint8_t> copy;
+	const uint8_t *p = src.readDirect(size);
+	if(!p)
 	{
-		uint8_t chunkheader = 0;
-		if(!src.read(chunkheader))
+		copy.resize(size);
+		if(size&&!src.readBytes(copy.data(),size))
 			return SourceGetError(src);
+		p = copy.data();
+	}
+	const uint8_t *e = p+size;
+
+	do
+	{
+		if(p==e) return Texture::ERROR_UNEXPECTED_EOF;
+
+		uint8_t chunkheader = *p++;
+
+		uint32_t n = (chunkheader&127)+1;
+		n = std::min(n,pixelcount-currentpixel);
+
+		uint8_t *d = data+currentpixel*bytespp;
 
 		if(chunkheader<128)
 		{
-			chunkheader++;
-			for(short counter = 0; counter<chunkheader&&currentpixel<pixelcount; counter++)
-			{
-				if(!src.readBytes(colorbuffer,bytespp))
-					return SourceGetError(src);
-
-				data[currentbyte+0] = colorbuffer[2];		  
-				data[currentbyte+1] = colorbuffer[1];
-				data[currentbyte+2] = colorbuffer[0];
-				if(hasAlpha)
-				{
-					data[currentbyte+3] = colorbuffer[3];
-				}
-
-				currentbyte += bytespp;
-				currentpixel++;
-			}
+			if((size_t)(e-p)<n*bytespp)
+				return Texture::ERROR_UNEXPECTED_EOF;
+
+			tgatex_swizzle(d,p,n,bytespp); p+=n*bytespp;
 		}
 		else
 		{
-			chunkheader -= 127;
-			if(!src.readBytes(colorbuffer,bytespp))
-				return SourceGetError(src);
-
-			for(short counter = 0; counter<chunkheader&&currentpixel<pixelcount; counter++)
-			{
-				data[currentbyte+0] = colorbuffer[2];		  
-				data[currentbyte+1] = colorbuffer[1];
-				data[currentbyte+2] = colorbuffer[0];
-				if(hasAlpha)
-				{
-					data[currentbyte+3] = colorbuffer[3];
-				}
-
-				currentbyte += bytespp;
-				currentpixel++;
-			}
+			if(e-p<bytespp)
+				return Texture::ERROR_UNEXPECTED_EOF;
+
+			tgatex_fill(d,p,n,bytespp); p+=bytespp;
 		}
 
+		currentpixel+=n;
+
 	}while(currentpixel<pixelcount);
 
 	//log_debug("pixel count = %d,current pixel = %d\n",pixelcount,currentpixel);
@@ -220,6 +284,8 @@ struct TgaTextureFilter : TextureFilter
 			return errnoToTextureError(src.getErrno(),Texture::ERROR_FILE_OPEN);
 		}
 
+		TGAHeaderT tgaheader; TGA tga; //2024
+
 		if(!src.readBytes(tgaheader.Header,sizeof(tgaheader.Header)))
 		{
 			return Texture::ERROR_BAD_DATA;
@@ -229,11 +295,11 @@ struct TgaTextureFilter : TextureFilter
 
 		if(memcmp(uTGAcompare,&tgaheader.Header,sizeof(tgaheader.Header))==0)
 		{
-			err = LoadUncompressedTGA(texture,src);
+			err = LoadUncompressedTGA(texture,src,tga);
 		}
 		else if(memcmp(cTGAcompare,&tgaheader.Header,sizeof(tgaheader.Header))==0)
 		{
-			err = LoadCompressedTGA(texture,src);
+			err = LoadCompressedTGA(texture,src,tga);
 		}
 		else
 		{
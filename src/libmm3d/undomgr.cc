@@ -23,6 +23,7 @@
 #include "mm3dtypes.h" //PCH
 
 #include "time.h"
+#include <typeinfo> //2024
 
 #include "undomgr.h"
 
@@ -38,10 +39,16 @@ bool UndoList::isEdit()const
 	for(Undo*ea:*this)
 	if(!ea->nonEdit()) return true; return false;
 }
+size_t UndoList::_count_bytes()
+{
+	m_bytes = 0;
+	for(Undo*ea:*this) m_bytes+=ea->size(); return m_bytes;
+}
 
 UndoManager::UndoManager()
 	: m_currentUndo(nullptr),
 	  m_currentList(nullptr),
+	  m_undoBytes(0),m_redoBytes(0),
 	  //m_listCombine(true), //RETIRED
 	  m_sizeLimit(0),
 	  m_countLimit(0),
@@ -95,7 +102,7 @@ void UndoManager::clear()
 		}
 		delete ea;
 	}
-	m_atomic.clear();
+	m_atomic.clear(); m_undoBytes = 0;
 
 	clearRedo();
 }
@@ -111,7 +118,7 @@ void UndoManager::clearRedo()
 		}
 		delete ea;
 	}
-	m_atomicRedo.clear();
+	m_atomicRedo.clear(); m_redoBytes = 0;
 }
 //void UndoManager::addUndo(Undo *u, bool listCombine)
 void UndoManager::addUndo(Undo *u, bool combine)
@@ -136,6 +143,8 @@ void UndoManager::addUndo(Undo *u, bool combine)
 
 void UndoManager::operationComplete(const char *opname, int compound_ms)
 {
+	LOG_PROFILE(); //2024
+
 	// if we have anything to undo
 	if(m_currentUndo)
 	{
@@ -181,6 +190,9 @@ void UndoManager::operationComplete(const char *opname, int compound_ms)
 
 					a->m_time = b->m_time; //!
 
+					m_undoBytes-=a->m_bytes;
+					m_undoBytes+=a->_count_bytes();
+
 					b->clear(); delete b;
 
 					m_currentList = nullptr; //HACK#2
@@ -191,6 +203,8 @@ void UndoManager::operationComplete(const char *opname, int compound_ms)
 		{
 			m_atomic.push_back(m_currentList);
 
+			m_undoBytes+=m_currentList->_count_bytes();
+
 			//NEW: Don't pester users for things like
 			//playing animations.
 			if(m_currentList->isEdit()) m_saveLevel++; 
@@ -224,6 +238,9 @@ UndoList *UndoManager::undo()
 		m_atomicRedo.push_back(m_atomic.back());
 		m_atomic.pop_back();
 
+		size_t sz = m_atomicRedo.back()->m_bytes;
+		m_undoBytes-=sz; m_redoBytes+=sz;
+
 		showStatistics();
 
 		//log_debug("Undo: %s\n",m_atomicRedo.back()->getOpName());
@@ -247,6 +264,9 @@ UndoList *UndoManager::redo()
 		m_atomic.push_back(m_atomicRedo.back());
 		m_atomicRedo.pop_back();
 
+		size_t sz = m_atomic.back()->m_bytes;
+		m_undoBytes+=sz; m_redoBytes-=sz;
+
 		showStatistics();
 
 		//log_debug("Redo: %s\n",m_atomic.back()->getOpName());
@@ -295,6 +315,9 @@ UndoList *UndoManager::undoCurrent()
 			m_atomicRedo.push_back(m_atomic.back());
 			m_atomic.pop_back();
 
+			size_t sz = m_atomicRedo.back()->m_bytes;
+			m_undoBytes-=sz; m_redoBytes+=sz;
+
 			//log_debug("Undo: %s\n",m_atomicRedo.back()->getOpName());
 			return m_atomicRedo.back();
 		}
@@ -344,6 +367,16 @@ bool UndoManager::combineWithList(Undo *u)
 	return false;
 }
 
+void UndoManager::appendUndo(Undo *u)
+{
+	assert(!m_atomic.empty()&&!m_currentList);
+
+	auto *l = m_atomic.back();
+	l->push_back(u); 
+	size_t sz = u->size();
+	l->m_bytes+=sz; m_undoBytes+=sz;
+}
+
 void UndoManager::pushUndoToList(Undo *u)
 {
 	if(!m_currentList)
@@ -355,70 +388,43 @@ void UndoManager::pushUndoToList(Undo *u)
 
 void UndoManager::showStatistics()const
 {
-	int undoItems = 0;
-	int redoItems = 0;
-	unsigned undoSize = 0;
-	unsigned redoSize = 0;
+	//2024: This had added up every Undo::size on every operation.
 
-	AtomicList::const_iterator it;
-	UndoList::const_iterator uit;
-
-	//log_debug("Undo:\n");
-	for(it = m_atomic.begin(); it!=m_atomic.end(); it++)
+	//log_debug("--------------- Undo statistics ---------------\n");
+	//log_debug(" undo:  %7d size,%5d lists\n",m_undoBytes,m_atomic.size());
+	//log_debug(" redo:  %7d size,%5d lists\n",m_redoBytes,m_atomicRedo.size());
+	//log_debug(" total: %7d size,%5d lists\n",m_undoBytes+m_redoBytes,m_atomic.size()+m_atomicRedo.size());
+	//log_debug("-----------------------------------------------\n");
+}
+void UndoManager::getStatistics(Statistics &undo, Statistics &redo)const
+{
+	for(int i=0;i<2;i++)
 	{
-		//log_debug("  %s\n",(*it)->getOpName());
-		undoItems += (*it)->size();
-		for(uit = (*it)->begin(); uit!=(*it)->end(); uit++)
-		{
-			undoSize += (*uit)->size();
-		}
-	}
-	//log_debug("\n");
+		auto &st = i?redo:undo; st.clear();
 
-	//log_debug("Redo:\n");
-	for(it = m_atomicRedo.begin(); it!=m_atomicRedo.end(); it++)
-	{
-		//log_debug("  %s\n",(*it)->getOpName());
-		redoItems += (*it)->size();
-		for(uit = (*it)->begin(); uit!=(*it)->end(); uit++)
+		for(auto*ea:i?m_atomicRedo:m_atomic) for(auto*ea2:*ea)
 		{
-			redoSize += (*uit)->size();
+			auto &t = st[typeid(*ea2).name()];
+			t.first+=ea2->size(); t.second++;
 		}
 	}
-	//log_debug("\n");
-
-	//log_debug("--------------- Undo statistics ---------------\n");
-	//log_debug(" undo:  %7d size,%5d items,%5d lists\n",undoSize,undoItems,m_atomic.size());
-	//log_debug(" redo:  %7d size,%5d items,%5d lists\n",redoSize,redoItems,m_atomicRedo.size());
-	//log_debug(" total: %7d size,%5d items,%5d lists\n",undoSize+redoSize,undoItems+redoItems,m_atomic.size()+m_atomicRedo.size());
-	//log_debug("-----------------------------------------------\n");
 }
 
-size_t UndoManager::getSize() //NEW
-{
-	size_t sum = 0;
-	for(auto*ea:m_atomic) for(auto*ea2:*ea)
-	sum+=ea2->size(); return sum;
-}
 void UndoManager::checkSize()
 {	
 	size_t count1 = 0, count2 = 0;
 
 	if(m_sizeLimit) //2019: Ignoring MAX_UNDO_LIST_SIZE
 	{
-		size_t size = getSize();
+		size_t size = m_undoBytes;
 
 		if(size>m_sizeLimit)
 		{
 			//log_debug("Undo list size is %d,freeing a list\n",size);
 
-			auto it = m_atomic.begin();
-			for(auto itt=m_atomic.end();it<itt;it++)
+			for(auto*ea:m_atomic)
 			{
-				size_t sum = 0;
-				for(Undo*ea:**it) sum+=ea->size();
-
-				size-=sum;
+				size-=ea->m_bytes;
 				
 				if(size>m_sizeLimit) 
 				{
@@ -435,16 +441,16 @@ void UndoManager::checkSize()
 		count2 = m_atomic.size()-m_countLimit;
 	}
 
-	size_t count = std::max(count1,count2);
-
-	auto itt = m_atomic.begin()+count;
-	for(auto it=itt-count;it<itt;it++)
+	for(size_t count=std::max(count1,count2);count-->0;)
 	{
-		for(Undo*ea:**it)
+		auto *l = m_atomic.front(); m_atomic.pop_front();
+
+		m_undoBytes-=l->m_bytes;
+
+		for(Undo*ea:*l)
 		{
 			ea->undoRelease(); ea->release();
 		}
-		delete *it;
+		delete l;
 	}
-	m_atomic.erase(itt-count,itt);
 }
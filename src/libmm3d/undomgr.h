@@ -26,6 +26,8 @@
 
 #include "mm3dtypes.h"
 
+#include <deque> //2024
+
 #include "undo.h" //template?
 
 class UndoList : public std::vector<Undo*>
@@ -38,6 +40,10 @@ public:
 
 	bool isEdit()const;
 
+	//2024: Sum of the Undo::size values, counted when the list is
+	//finished (see UndoManager::operationComplete.)
+	size_t getByteSize()const{ return m_bytes; }
+
 protected:
 
 	friend class UndoManager;
@@ -45,9 +51,14 @@ protected:
 	std::string m_name;
 
 	time_t m_time; //2023
+
+	size_t m_bytes = 0; //2024
+
+	size_t _count_bytes();
 };
 
-typedef std::vector<UndoList*> AtomicList;
+//2024: This was a std::vector but checkSize erases from the front.
+typedef std::deque<UndoList*> AtomicList;
 
 class UndoManager
 {
@@ -82,7 +93,10 @@ public:
 	const char *getRedoOpName()const;
 
 	//Exposing in order to implement Model::appendUndo.
-	AtomicList &getUndoStack(){ return m_atomic; }
+	const AtomicList &getUndoStack()const{ return m_atomic; }
+
+	//2024: Adds to the last completed list. (Model::appendUndo.)
+	void appendUndo(Undo *u);
 
 	//2022: This is helpful for sorted_list based undo
 	//object performance.
@@ -109,10 +123,17 @@ public:
 
 	void showStatistics()const;
 
+	//2024: Bytes and number of Undo objects by type (typeid name)
+	//in the undo and redo lists. This has to visit every Undo so
+	//it's for diagnostic purposes. 
+	typedef std::map<std::string,std::pair<size_t,size_t>> Statistics;
+	void getStatistics(Statistics &undo, Statistics &redo)const;
+
 	void setSizeLimit(unsigned sizeLimit) { m_sizeLimit  = sizeLimit; };
 	void setCountLimit(unsigned countLimit){ m_countLimit = countLimit; };
 
-	size_t getSize(); //NEW
+	size_t getSize()const{ return m_undoBytes; } //NEW
+	size_t getRedoSize()const{ return m_redoBytes; } //2024
 
 protected:
 
@@ -132,6 +153,9 @@ protected:
 	AtomicList	m_atomicRedo;
 	//bool			m_listCombine; //RETIRED
 
+	size_t		m_undoBytes; //2024
+	size_t		m_redoBytes; //2024
+
 	unsigned	  m_sizeLimit;
 	unsigned	  m_countLimit;
 	int			 m_saveLevel;
@@ -51,53 +51,99 @@ void weldSelectedVertices(Model *model, double tolerance, int &unweldnum, int &w
 	int_list vert;
 	model->getSelectedVertices(vert);
 
-	std::map<int,int> welded;
-
 	int weldSources = 0;
 	int weldTargets = 0;
 
-	int_list::iterator it;
-	int_list::iterator it2;
+	//2024: This used to compare every pair of selected vertices. A
+	//vertex is welded to the first vertex before it (in selection
+	//order) that is within tolerance, so if vertices are put into
+	//a grid with tolerance sized cells as they're visited only the
+	//27 cells around a vertex need to be looked at.
+	const unsigned none = ~0u;
+	unsigned vN = model->getVertexCount(), sN = (unsigned)vert.size();
+	std::vector<unsigned> welded(vN,none);
 
-	// Find vertices to weld and store in "welded"
-	for(it = vert.begin(); it!=vert.end(); it++)
+	if(tolerance>0&&sN>1)
 	{
-		bool match = false;
-		it2 = it;
-		it2++;
-		for(; it2!=vert.end(); it2++)
+		std::vector<double> coords(sN*3);
+		for(unsigned i=0;i<sN;i++)
+		model->getVertexCoords(vert[i],&coords[i*3]);
+
+		//Slightly oversized so rounding can't put a pair that's in
+		//tolerance more than 1 cell apart.
+		double cell = 1/(tolerance*(1+1e-9));
+		auto cell_of = [&](double x)->int64_t
 		{
-			double a[3];
-			double b[3];
-
-			model->getVertexCoords(*it,a);
-			model->getVertexCoords(*it2,b);
-
-			double d = distance(a[0],a[1],a[2],b[0],b[1],b[2]);
+			x = floor(x*cell);
+			return (int64_t)std::max(-4e18,std::min(4e18,x));
+		};
+		//Cells that land on the same key just get searched together.
+		auto key = [](int64_t x, int64_t y, int64_t z)->uint64_t
+		{
+			return (uint64_t)x*73856093^(uint64_t)y*19349663^(uint64_t)z*83492791;
+		};
+		std::unordered_map<uint64_t,unsigned> cells; cells.reserve(sN);
+		std::vector<unsigned> head,tail,next(sN,none);
 
-			if(d<tolerance&&welded.find(*it2)==welded.end())
+		std::vector<char> target(sN);
+		for(unsigned j=0;j<sN;j++)
+		{
+			double *b = &coords[j*3];
+			int64_t c[3];
+			for(int i=3;i-->0;) c[i] = cell_of(b[i]);
+
+			unsigned first = none;
+			for(int x=-1;x<=1;x++)
+			for(int y=-1;y<=1;y++)
+			for(int z=-1;z<=1;z++)
+			{
+				auto it = cells.find(key(c[0]+x,c[1]+y,c[2]+z));
+				if(it==cells.end()) continue;
+
+				//Lists are in selection order so the first match is
+				//the earliest in this cell.
+				for(unsigned i=head[it->second];i<first;i=next[i])
+				{
+					double *a = &coords[i*3];
+					double d = distance(a[0],a[1],a[2],b[0],b[1],b[2]);
+					if(d<tolerance)
+					{
+						first = i; break;
+					}
+				}
+			}
+			if(first!=none)
 			{
-				//log_debug("weld vertices %d and %d\n",*it,*it2);
-				welded[*it2] = *it;
-				match = true;
+				welded[vert[j]] = vert[first];
 				weldSources++;
+				if(!target[first])
+				{
+					target[first] = 1; weldTargets++;
+				}
 			}
-		}
 
-		if(match)
-		{
-			weldTargets++;
+			auto ins = cells.emplace(key(c[0],c[1],c[2]),(unsigned)head.size());
+			if(ins.second)
+			{
+				head.push_back(j); tail.push_back(j);
+			}
+			else
+			{
+				unsigned &t = tail[ins.first->second];
+				next[t] = j; t = j;
+			}
 		}
 	}
 
 	// Move triangles to welded vertices
+	if(weldSources)
 	for(int t=0,tN=model->getTriangleCount();t<tN;t++)
 	{
 		unsigned v[3];
 		bool changeVertices = false;
 		model->getTriangleVertices(t,v[0],v[1],v[2]);
 		for(int i=3;i-->0;)
-		if(welded.find(v[i])!=welded.end())
+		if(welded[v[i]]!=none)
 		{
 			v[i] = welded[v[i]];
 			changeVertices = true;
@@ -39,6 +39,9 @@
 //#include "mlocale.h"
 //#include "texturetest.h"
 #include "texmgr.h"
+#include "parallel.h"
+
+#include <thread>
 
 bool cmdline_runcommand = false;
 bool cmdline_runui = true;
@@ -46,6 +49,7 @@ bool cmdline_resume = false;
 
 static bool cmdline_doConvert = false;
 static std::string cmdline_convertFormat = "";
+static unsigned cmdline_jobs = 1; //2024
 
 static bool cmdline_doBatch = false;
 
@@ -79,6 +83,7 @@ static void cmdline_print_help(const char *progname)
 	printf("		--script [file]	 Run script [file] on models\n");
 #endif // HAVE_LUALIB
 	printf("		--convert [format] Save models to format [format]\n");
+	printf("  -j  --jobs [n]		 Convert [n] models at a time (0 for all cores)\n");
 	printf("								 \n");
 	printf("		--language [code]  Use language [code] instead of system default\n");
 	printf("								 \n");
@@ -86,6 +91,7 @@ static void cmdline_print_help(const char *progname)
 	printf("		--no-plugin [foo]  Disable plugin [foo]\n");
 	printf("								 \n");
 	printf("		--sysinfo			 Display system information (for bug reports)\n");
+	printf("		--profile[=file]	Print timings (and write Chrome trace JSON to [file])\n");
 	printf("		--debug				Display debug messages in console\n");
 	printf("		--warnings			Display warning messages in console\n");
 	printf("		--errors			  Display error messages in console\n");
@@ -164,6 +170,8 @@ enum cmdline_Mm3dOptionsE
 	OptVerbose, //NEW
 	OptResume,	//2022
 	OptResume2, //2024
+	OptJobs, //2024
+	OptProfile, //2024
 	OptMAX
 };
 
@@ -181,10 +189,12 @@ int init_cmdline(int &argc,char *argv[])
 	clm.addOption(OptNoPlugins,0,"no-plugins");
 	clm.addOption(OptNoPlugin,0,"no-plugin",nullptr,true);
 	clm.addOption(OptConvert,0,"convert",nullptr,true);
+	clm.addOption(OptJobs,'j',"jobs",nullptr,true);
 	clm.addOption(OptLanguage,0,"language",nullptr,true);
 	clm.addOption(OptScript,0,"script",nullptr,true);
 
 	clm.addOption(OptSysinfo,0,"sysinfo");
+	clm.addOption(OptProfile,0,"profile"); //--profile=file
 	clm.addOption(OptDebug,0,"debug");
 	clm.addOption(OptWarnings,0,"warnings");
 	clm.addOption(OptErrors,0,"errors");
@@ -251,6 +261,12 @@ int init_cmdline(int &argc,char *argv[])
 		cmdline_runcommand = true;
 		cmdline_runui = false;
 	}
+	if(clm.isSpecified(OptJobs))
+	{
+		int n = atoi(clm.stringValue(OptJobs));
+		if(n<=0) n = parallel_threads();
+		cmdline_jobs = std::max(1,n);
+	}
 	if(clm.isSpecified(OptLanguage))
 		mlocale_set(clm.stringValue(OptLanguage));
 
@@ -280,6 +296,9 @@ int init_cmdline(int &argc,char *argv[])
 
 	cmdline_resume = clm.isSpecified(OptResume)||clm.isSpecified(OptResume2);
 
+	if(clm.isSpecified(OptProfile)) //2024
+		log_profile_init(clm.stringValue(OptProfile));
+
 	if(clm.isSpecified(OptDebug))
 		log_enable_debug(true);
 	if(clm.isSpecified(OptWarnings))
@@ -314,6 +333,86 @@ int init_cmdline(int &argc,char *argv[])
 	argc = offset; return 0;
 }
 
+//2024: --jobs splits --convert between threads. Each thread has its
+//own filters (they aren't reentrant.) Messages are held until every
+//model is done so they're printed in the same order as cmdline_command
+//prints them: every input's loading messages, then every output's.
+//Unlike cmdline_command the models aren't kept in cmdline_models.
+static int cmdline_convert_jobs()
+{
+	struct job
+	{
+		std::string file,out,readError,writeError; 
+		
+		msg_list read,write; bool failed = false;
+	};
+	std::vector<job> jobs(cmdline_argList.size());
+	auto it = cmdline_argList.begin();
+	for(auto&ea:jobs) ea.file = *it++;
+
+	std::atomic<size_t> next(0);
+	auto work = [&]()
+	{
+		extern void init_std_filters(FilterManager*);
+		FilterManager *mgr = FilterManager::create();
+		init_std_filters(mgr);
+
+		for(size_t i;(i=next++)<jobs.size();)
+		{
+			auto &j = jobs[i];
+
+			Model::ModelErrorE err = Model::ERROR_NONE;
+			Model *m = new Model;
+			msg_capture(&j.read);
+			if((err=mgr->readFile(m,j.file.c_str()))==Model::ERROR_NONE)
+			{
+				m->loadTextures(0); //??? FIX ME (Doesn't belong here.)
+
+				msg_capture(&j.write);
+				j.out = replaceExtension(m->getFilename(),cmdline_convertFormat.c_str());
+				if((err=mgr->writeFile(m,j.out.c_str(),true,FilterManager::WO_ModelNoPrompt))!=Model::ERROR_NONE)
+				{
+					j.failed = true;
+
+					j.writeError = Model::errorToString(err,m);
+				}
+			}
+			else j.readError = Model::errorToString(err,m);
+			msg_capture(nullptr);
+
+			delete m;
+		}
+
+		mgr->destroy();
+
+		model_free_primitives(); //Recycling lists are per thread.
+	};
+
+	unsigned n = (unsigned)std::min<size_t>(cmdline_jobs,jobs.size());
+	std::vector<std::thread> threads;
+	while(threads.size()+1<n) threads.push_back(std::thread(work));
+	work();
+	for(auto&ea:threads) ea.join();
+
+	for(auto&ea:jobs)
+	{
+		msg_replay(ea.read);
+
+		if(!ea.readError.empty())
+		msg_error("%s: %s",ea.file.c_str(),transll(ea.readError.c_str()));
+	}
+	int errors = 0; for(auto&ea:jobs)
+	{
+		if(ea.failed) errors++;
+
+		msg_replay(ea.write);
+
+		if(!ea.writeError.empty())
+		msg_error("%s: %s",ea.out.c_str(),transll(ea.writeError.c_str()));
+	}
+	return errors;
+}
+
 void shutdown_cmdline()
 {
 	cmdline_deleteOpenModels();
@@ -336,6 +435,11 @@ int cmdline_command()
 		return 0;
 	}
 
+	if(cmdline_jobs>1&&cmdline_doConvert&&!cmdline_doScripts&&!cmdline_doBatch)
+	{
+		return cmdline_convert_jobs();
+	}
+
 	FilterManager *mgr = FilterManager::getInstance();
 
 	StringList::iterator it = cmdline_argList.begin();
@@ -1957,9 +1957,16 @@ bool ModelViewport::getParentCoords(int bs, int bx, int by, double o[4], bool se
 		if(curType==Model::PT_MAX)
 		if(mask&1<<Model::PT_Vertex)
 		{
-			i = -1; for(auto*ea:model->getVertexList())
+			//2024: Only visit vertices the grid says are near.
+			auto &vl = model->getVertexList();
+			std::vector<unsigned> found;
+			model->_screenIndex(mat,Model::ScreenIndex::Vertices).findVertices
+			(o[0]-maxDist,o[1]-maxDist,o[0]+maxDist,o[1]+maxDist,found);
+
+			for(unsigned j:found)
 			{
-				i++; if(selected||!ea->m_selected)
+				i = (int)j; auto *ea = vl[j];
+				if(selected||!ea->m_selected)
 				{
 					if(ea->visible(lv))
 					{
@@ -41,12 +41,10 @@
 #include "smdfilter.h"
 */
 
-extern void init_std_filters()
+extern void init_std_filters(FilterManager *mgr)
 {
 	//log_debug("initializing standard filters\n");
 
-	FilterManager *mgr = FilterManager::getInstance();
-
 	typedef ModelFilter::PromptF prompt;
 	typedef ModelFilter *filter(ModelFilter::PromptF);
 
@@ -91,4 +89,7 @@ extern void init_std_filters()
 	extern prompt smdprompt;
 	mgr->registerFilter(smdfilter(smdprompt));
 }
-
+extern void init_std_filters()
+{
+	init_std_filters(FilterManager::getInstance());
+}